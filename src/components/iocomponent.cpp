@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "iocomponent.h"
 #include "circuitwidget.h"
 #include "propdialog.h"
@@ -19,6 +21,7 @@
 IoComponent::IoComponent( QString type, QString id)
            : Component( type, id )
            , LogicFamily()
+           , m_outBus( id+"-outBus" )
 {
     m_outValue = 0;
 
@@ -124,7 +127,7 @@ void IoComponent::runOutputs()
     for( uint i=0; i<m_outPin.size(); ++i )
     {
         bool state = m_outValue & (1<<i);
-        m_outPin[i]->scheduleState( state, 0 );
+        m_outBus.scheduleState( m_outPin[i], state );
     }
 }
 
@@ -136,7 +139,7 @@ void IoComponent::scheduleOutPuts( eElement* el )
         if( m_nextOutVal == m_outValue ) return;
         m_outValue = m_nextOutVal;
         for( uint i=0; i<m_outPin.size(); ++i )
-            m_outPin[i]->scheduleState( m_outValue & (1<<i), 0 );
+            m_outBus.scheduleState( m_outPin[i], m_outValue & (1<<i) );
         return;
     }
     if(  m_outQueue.empty() )
@@ -155,6 +158,35 @@ void IoComponent::scheduleOutPuts( eElement* el )
     m_outQueue.push( m_nextOutVal );
 }
 
+void IoComponent::saveOutState( QDataStream& out ) // Queued times are absolute
+{
+    std::queue<uint> outQueue = m_outQueue;
+    std::queue<uint64_t> timeQueue = m_timeQueue;
+
+    QVector<quint32> outVals;
+    QVector<quint64> times;
+    while( !outQueue.empty()  ) { outVals.append( outQueue.front() ); outQueue.pop(); }
+    while( !timeQueue.empty() ) { times.append( timeQueue.front() ); timeQueue.pop(); }
+
+    out << (quint32)m_outValue << (quint32)m_nextOutVal << outVals << times;
+}
+
+void IoComponent::loadOutState( QDataStream& in, eElement* el ) // First queued event is restored by Simulator
+{
+    quint32 outValue, nextOutVal;
+    QVector<quint32> outVals;
+    QVector<quint64> times;
+    in >> outValue >> nextOutVal >> outVals >> times;
+
+    m_outValue   = outValue;
+    m_nextOutVal = nextOutVal;
+    m_outQueue  = std::queue<uint>();
+    m_timeQueue = std::queue<uint64_t>();
+    for( quint32 val  : outVals ) m_outQueue.push( val );
+    for( quint64 time : times   ) m_timeQueue.push( time );
+    m_eElement = el;
+}
+
 void IoComponent::setSupplyV( double v )
 {
     if( v < 0 ) v = 0;
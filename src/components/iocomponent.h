@@ -10,9 +10,11 @@
 
 #include "component.h"
 #include "logicfamily.h"
+#include "iobus.h"
 
 class eElement;
 class IoPin;
+class QDataStream;
 
 class IoComponent : public Component, public LogicFamily
 {
@@ -29,6 +31,9 @@ class IoComponent : public Component, public LogicFamily
         void runOutputs();
         void scheduleOutPuts( eElement* el );
 
+        void saveOutState( QDataStream& out );  // Checkpoint: output values and queued changes
+        void loadOutState( QDataStream& in, eElement* el );
+
         void updtProperties();
 
         virtual void setSupplyV( double v ) override;
@@ -92,6 +97,8 @@ class IoComponent : public Component, public LogicFamily
 
         eElement* m_eElement;
 
+        IoBus m_outBus;     // Output edges of all pins in one event
+
         std::vector<IoPin*> m_inPin;
         std::vector<IoPin*> m_outPin;
         std::vector<IoPin*> m_otherPin;
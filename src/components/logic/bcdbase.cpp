@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "bcdbase.h"
 #include "iopin.h"
 
@@ -58,3 +60,15 @@ void BcdBase::voltChanged()
 
     m_digit = m_values[a*1+b*2+c*4+d*8];
 }
+
+void BcdBase::saveState( QDataStream& out )
+{
+    LogicComponent::saveState( out );
+    out << m_digit;
+}
+
+void BcdBase::loadState( QDataStream& in )
+{
+    LogicComponent::loadState( in );
+    in >> m_digit;
+}
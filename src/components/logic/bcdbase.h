@@ -19,6 +19,8 @@ class BcdBase : public LogicComponent
         virtual void initialize() override;
         virtual void stamp() override;
         virtual void voltChanged() override;
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
 
     protected:
  static const uint8_t m_values[];
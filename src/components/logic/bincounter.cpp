@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "bincounter.h"
 #include "itemlibrary.h"
 #include "connector.h"
@@ -103,6 +105,20 @@ void BinCounter::voltChanged()
     IoComponent::scheduleOutPuts( this );
 }
 
+void BinCounter::saveState( QDataStream& out )
+{
+    LogicComponent::saveState( out );
+    out << (qint32)m_Counter;
+}
+
+void BinCounter::loadState( QDataStream& in )
+{
+    LogicComponent::loadState( in );
+    qint32 counter;
+    in >> counter;
+    m_Counter = counter;
+}
+
 void BinCounter::setSrInv( bool inv )
 {
     m_resetInv = inv;
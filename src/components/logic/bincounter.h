@@ -27,6 +27,8 @@ class BinCounter : public LogicComponent
 
         virtual void stamp() override;
         virtual void voltChanged() override;
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
         virtual void runEvent() override { IoComponent::runOutputs(); }
 
         int maxVal() { return m_TopValue; }
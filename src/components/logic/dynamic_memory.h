@@ -24,6 +24,7 @@ class DynamicMemory : public LogicComponent, public MemData
         virtual void updateStep() override;
         virtual void voltChanged() override;
         virtual void runEvent() override;
+        virtual bool unsavedState() override { return true; }
 
         int rowAddrBits() { return m_rowAddrBits; }
         int colAddrBits() { return m_colAddrBits; }
@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "flipflopbase.h"
 #include "simulator.h"
 #include "circuit.h"
@@ -79,6 +81,18 @@ void FlipFlopBase::voltChanged()
     scheduleOutPuts( this );
 }
 
+void FlipFlopBase::saveState( QDataStream& out )
+{
+    LogicComponent::saveState( out );
+    out << m_Q0;
+}
+
+void FlipFlopBase::loadState( QDataStream& in )
+{
+    LogicComponent::loadState( in );
+    in >> m_Q0;
+}
+
 void FlipFlopBase::setSrInv( bool inv )
 {
     if( m_srInv == inv ) return;
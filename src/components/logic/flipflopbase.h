@@ -23,6 +23,8 @@ class FlipFlopBase : public LogicComponent
         virtual void stamp() override;
         virtual void updateStep() override;
         virtual void voltChanged() override;
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
         virtual void runEvent() override{ IoComponent::runOutputs(); }
 
         bool sPinState();
@@ -24,6 +24,8 @@
 
 #define tr(str) simulideTr("Function",str)
 
+Function* Function::m_fu = nullptr;
+
 Component* Function::construct( QString type, QString id )
 { return new Function( type, id ); }
 
@@ -39,38 +41,17 @@ LibraryItem* Function::libraryItem()
 
 Function::Function( QString type, QString id )
         : IoComponent( type, id )
-        , ScriptBase( id )
+        , ScriptBase( id, "Function" )
 {
     m_lastDir = Circuit::self()->getFilePath();
     m_width = 4;
 
     m_compiled = false;
+    m_useTable = false;
+    m_lastOutVal = 0;
 
     m_voltChanged = nullptr;
-    m_aEngine->RegisterObjectType("Function",0, asOBJ_REF | asOBJ_NOCOUNT );
-    m_aEngine->RegisterGlobalProperty("Function fu", this );
-
-    int r=0;
-    r += m_aEngine->RegisterObjectMethod("Function", "bool getInputState(int pin)"
-                                       , asMETHODPR( Function, getInputState, (int), bool)
-                                       , asCALL_THISCALL );
-
-    r += m_aEngine->RegisterObjectMethod("Function", "double getInputVoltage(int pin)"
-                                       , asMETHODPR( Function, getInputVoltage, (int), double)
-                                       , asCALL_THISCALL );
-
-    r += m_aEngine->RegisterObjectMethod("Function", "void setOutputState(int pin, bool s)"
-                                       , asMETHODPR( Function, setOutputState, (int,bool), void)
-                                       , asCALL_THISCALL );
-
-    r += m_aEngine->RegisterObjectMethod("Function", "void setOutputVoltage(int pin, double v)"
-                                       , asMETHODPR( Function, setOutputVoltage, (int,double), void)
-                                       , asCALL_THISCALL );
-
-    r += m_aEngine->RegisterObjectMethod("Function", "double getOutputVoltage(int pin)"
-                                       , asMETHODPR( Function, getOutputVoltage, (int), double)
-                                       , asCALL_THISCALL );
-    if( r < 0 ) qDebug() << "Function::Function error Registering Function";
+    if( newEngine() ) registerScript( m_aEngine ); // Engine shared by all Functions
 
     setNumInputs( 2 );                           // Create Input Pins
     setNumOutputs( 1 );
@@ -103,6 +84,38 @@ Function::Function( QString type, QString id )
 }
 Function::~Function(){}
 
+void Function::registerScript( asIScriptEngine* engine )
+{
+    engine->RegisterObjectType("Function",0, asOBJ_REF | asOBJ_NOCOUNT );
+    engine->RegisterGlobalProperty("Function@ fu", &m_fu );
+
+    int r=0;
+    r += engine->RegisterObjectMethod("Function", "bool getInputState(int pin)"
+                                    , asMETHODPR( Function, getInputState, (int), bool)
+                                    , asCALL_THISCALL );
+
+    r += engine->RegisterObjectMethod("Function", "double getInputVoltage(int pin)"
+                                    , asMETHODPR( Function, getInputVoltage, (int), double)
+                                    , asCALL_THISCALL );
+
+    r += engine->RegisterObjectMethod("Function", "void setOutputState(int pin, bool s)"
+                                    , asMETHODPR( Function, setOutputState, (int,bool), void)
+                                    , asCALL_THISCALL );
+
+    r += engine->RegisterObjectMethod("Function", "void setOutputVoltage(int pin, double v)"
+                                    , asMETHODPR( Function, setOutputVoltage, (int,double), void)
+                                    , asCALL_THISCALL );
+
+    r += engine->RegisterObjectMethod("Function", "bool getOutputState(int pin)"
+                                    , asMETHODPR( Function, getOutputState, (int), bool)
+                                    , asCALL_THISCALL );
+
+    r += engine->RegisterObjectMethod("Function", "double getOutputVoltage(int pin)"
+                                    , asMETHODPR( Function, getOutputVoltage, (int), double)
+                                    , asCALL_THISCALL );
+    if( r < 0 ) qDebug() << "Function::registerScript error Registering Function";
+}
+
 void Function::stamp()
 {
     IoComponent::initState();
@@ -111,21 +124,36 @@ void Function::stamp()
 
     if( !m_compiled )
     {
+        m_useTable = createTable();
+        if( m_useTable ) { m_compiled = true; return; } // Script not needed
+
         createScript();
         int r = compileScript();
         if( r < 0 ) return;
 
         m_compiled = true;
 
-        m_voltChanged = m_aEngine->GetModule(0)->GetFunctionByDecl("void voltChanged()");
+        m_voltChanged = m_asModule->GetFunctionByDecl("void voltChanged()");
     }
 }
 
 void Function::voltChanged()
 {
+    if( m_useTable )
+    {
+        uint inputs = 0;
+        for( uint i=0; i<m_inPin.size(); ++i )
+            if( m_inPin[i]->getInpState() ) inputs |= 1<<i;
+
+        m_nextOutVal = m_truthTable[inputs];
+        scheduleOutPuts( this );
+        return;
+    }
     if( !m_voltChanged ) return;
+    m_lastOutVal = m_nextOutVal;
     m_nextOutVal = 0;
 
+    m_fu = this;  // Module is shared with other Functions using same expressions
     callFunction( m_voltChanged );
     scheduleOutPuts( this );
 }
@@ -157,6 +185,12 @@ void Function::setOutputVoltage( int pin, double v )
     m_outPin[pin]->m_nextState = false; // Force Pin update
 }
 
+bool Function::getOutputState( int pin ) // Value of oN in last call, not delayed Pin state
+{
+    if( (uint)pin >= m_outPin.size() ) return false;
+    return m_lastOutVal & 1<<pin;
+}
+
 double Function::getOutputVoltage( int pin )
 {
     if( (uint)pin >= m_outPin.size() ) return 0;
@@ -172,7 +206,7 @@ void Function::setFunctions( QString f )
 
 void Function::createScript()
 {
-    m_script = "\n// "+m_id+" Script --------;\n";
+    m_script = "\n// Function Script --------;\n"; // Same text for same expressions: module is shared
 
     m_script += "\n// Declaring Variables:\n";
     for( uint i=0; i<m_inPin.size(); ++i )
@@ -200,6 +234,9 @@ void Function::createScript()
     {
         QString n = QString::number(i);
         m_script += "  vo"+n+" = fu.getOutputVoltage("+n+");\n";
+
+        QString func = ( (int)i < m_funcList.size() ) ? m_funcList.at( i ) : "";
+        if( !func.remove(" ").toLower().startsWith("vo") ) m_script += "  o"+n+"  = fu.getOutputState("+n+");\n"; // Globals are shared: restore this instance values
     }
     m_script += "\n  // Setting Outputs:\n";
     for( int i=0; i<m_funcList.size(); ++i )
@@ -228,6 +265,132 @@ void Function::createScript()
     //qDebug() << m_script.toLocal8Bit().data();
 }
 
+enum boolOp_t{ // Truth table program: RPN operations
+    opInput=0,     // Input number added to opInput
+    opNot=-1,
+    opAnd=-2,
+    opOr =-3,
+    opXor=-4,
+    opTrue=-5,
+    opFalse=-6
+};
+
+bool Function::createTable()
+{
+    uint inputs  = m_inPin.size();
+    uint outputs = m_outPin.size();
+    if( inputs > 16 || outputs > 32 ) return false;
+
+    std::vector<std::vector<int>> programs( outputs );
+    for( int i=0; i<m_funcList.size(); ++i )
+    {
+        if( i >= (int)outputs ) break;
+
+        QString func = m_funcList.at( i );
+        func = func.remove(" ").toLower();
+        if( func.isEmpty() ) continue;
+
+        int pos = 0;
+        if( !parseOr( func, pos, &programs[i] ) || pos != func.size() ) return false; // Not boolean: use script
+
+        for( int op : programs[i] ) if( op >= opInput && op-opInput >= (int)inputs ) return false;
+    }
+    uint size = 1<<inputs;
+    m_truthTable.assign( size, 0 );
+
+    std::vector<bool> stack;
+    for( uint o=0; o<outputs; ++o )
+    {
+        if( programs[o].empty() ) continue;
+
+        for( uint in=0; in<size; ++in )
+        {
+            stack.clear();
+            for( int op : programs[o] )
+            {
+                if( op >= opInput ) { stack.push_back( in & (1<<(op-opInput)) ); continue; }
+                switch( op ) {
+                    case opTrue:  stack.push_back( true );  break;
+                    case opFalse: stack.push_back( false ); break;
+                    case opNot:   stack.back() = !stack.back(); break;
+                    default:{
+                        bool b = stack.back(); stack.pop_back();
+                        bool a = stack.back();
+                        if     ( op == opAnd ) stack.back() = a && b;
+                        else if( op == opOr  ) stack.back() = a || b;
+                        else                   stack.back() = a != b;
+            }   }   }
+            if( stack.back() ) m_truthTable[in] |= 1<<o;
+    }   }
+    return true;
+}
+
+// Same precedence as the script: ! then ^ then & then |
+bool Function::parseOr( QString& e, int& pos, std::vector<int>* prog )
+{
+    if( !parseAnd( e, pos, prog ) ) return false;
+    while( pos < e.size() && e.at( pos ) == '|' )
+    {
+        if( !parseAnd( e, ++pos, prog ) ) return false;
+        prog->push_back( opOr );
+    }
+    return true;
+}
+
+bool Function::parseAnd( QString& e, int& pos, std::vector<int>* prog )
+{
+    if( !parseXor( e, pos, prog ) ) return false;
+    while( pos < e.size() && e.at( pos ) == '&' )
+    {
+        if( !parseXor( e, ++pos, prog ) ) return false;
+        prog->push_back( opAnd );
+    }
+    return true;
+}
+
+bool Function::parseXor( QString& e, int& pos, std::vector<int>* prog )
+{
+    if( !parseUnary( e, pos, prog ) ) return false;
+    while( pos < e.size() && e.at( pos ) == '^' )
+    {
+        if( !parseUnary( e, ++pos, prog ) ) return false;
+        prog->push_back( opXor );
+    }
+    return true;
+}
+
+bool Function::parseUnary( QString& e, int& pos, std::vector<int>* prog )
+{
+    if( pos >= e.size() ) return false;
+    QChar c = e.at( pos );
+
+    if( c == '!' )
+    {
+        if( !parseUnary( e, ++pos, prog ) ) return false;
+        prog->push_back( opNot );
+        return true;
+    }
+    if( c == '(' )
+    {
+        if( !parseOr( e, ++pos, prog ) ) return false;
+        if( pos >= e.size() || e.at( pos ) != ')' ) return false;
+        pos++;
+        return true;
+    }
+    if( c == 'i' )                       // Input: i0, i1...
+    {
+        int start = ++pos;
+        while( pos < e.size() && e.at( pos ).isDigit() ) pos++;
+        if( pos == start ) return false;
+        prog->push_back( opInput+e.mid( start, pos-start ).toInt() );
+        return true;
+    }
+    if( e.mid( pos, 4 ) == "true"  ) { pos += 4; prog->push_back( opTrue );  return true; }
+    if( e.mid( pos, 5 ) == "false" ) { pos += 5; prog->push_back( opFalse ); return true; }
+
+    return false;                        // Anything else needs the script
+}
+
 void Function::contextMenu( QGraphicsSceneContextMenuEvent* event, QMenu* menu )
 {
     menu->addSeparator();
@@ -299,6 +462,7 @@ void Function::setNumInputs( int inputs )
 {
     if( (uint)inputs == m_inPin.size() ) return;
     if( inputs < 1 ) return;
+    m_compiled = false;
 
     m_height = m_outPin.size()*2-1;
     if((uint) inputs > m_height ) m_height = inputs;
@@ -312,6 +476,7 @@ void Function::setNumOutputs( int outs )
 {
     if( (uint)outs == m_outPin.size() ) return;
     if( outs < 1 ) return;
+    m_compiled = false;
     
     updateArea( m_inPin.size(), outs );
     int halfH = (m_height/2)*8;
@@ -26,6 +26,10 @@ class Function : public IoComponent, public ScriptBase
         virtual void voltChanged() override;
         virtual void runEvent() override { IoComponent::runOutputs(); }
 
+        virtual void saveState( QDataStream& out ) override { IoComponent::saveOutState( out ); }
+        virtual void loadState( QDataStream& in ) override { IoComponent::loadOutState( in, this ); }
+        virtual bool unsavedState() override { return false; } // Outputs only depend on inputs
+
         QString functions() { return m_funcList.join(","); }
         void setFunctions( QString f );
 
@@ -38,6 +42,7 @@ class Function : public IoComponent, public ScriptBase
         double getInputVoltage( int pin );
         void   setOutputState( int pin, bool s );
         void   setOutputVoltage( int pin, double v );
+        bool   getOutputState( int pin );
         double getOutputVoltage( int pin );
         
     public slots:
@@ -52,7 +57,22 @@ class Function : public IoComponent, public ScriptBase
         void createScript();
         void updateArea( uint ins, uint outs );
 
+        // Boolean only functions: truth table indexed by input states
+        bool createTable();
+        bool parseOr(    QString& e, int& pos, std::vector<int>* prog );
+        bool parseAnd(   QString& e, int& pos, std::vector<int>* prog );
+        bool parseXor(   QString& e, int& pos, std::vector<int>* prog );
+        bool parseUnary( QString& e, int& pos, std::vector<int>* prog );
+
+ static void registerScript( asIScriptEngine* engine );
+ static Function* m_fu; // Instance running script: "fu" in script
+
         bool m_compiled;
+        bool m_useTable;
+
+        uint m_lastOutVal; // Output states set by this instance in last call
+
+        std::vector<uint> m_truthTable; // Output values by input states
 
         asIScriptFunction* m_voltChanged;
         QStringList m_funcList;
@@ -25,6 +25,7 @@ class Memory : public IoComponent, public eElement, public MemData
         virtual void updateStep() override;
         virtual void voltChanged() override;
         virtual void runEvent() override { IoComponent::runOutputs(); }
+        virtual bool unsavedState() override { return true; }
 
         void setMem( QString m );
         QString getMem();
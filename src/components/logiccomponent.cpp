@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "logiccomponent.h"
 #include "circuitwidget.h"
 #include "simulator.h"
@@ -22,6 +24,20 @@ LogicComponent::LogicComponent( QString type, QString id )
     m_tristate  = false;
     m_outEnable = true;
 }
+
+void LogicComponent::saveState( QDataStream& out ) // Pin states are saved by IoPins
+{
+    IoComponent::saveOutState( out );
+    out << m_clock << (quint8)m_clkState << m_outEnable;
+}
+
+void LogicComponent::loadState( QDataStream& in )
+{
+    IoComponent::loadOutState( in, this );
+    quint8 clkState;
+    in >> m_clock >> clkState >> m_outEnable;
+    m_clkState = (clkState_t)clkState;
+}
 LogicComponent::~LogicComponent(){}
 
 void LogicComponent::stamp()
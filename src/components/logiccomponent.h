@@ -19,6 +19,9 @@ class LogicComponent : public IoComponent, public eClockedDevice
 
         virtual void stamp() override;
 
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
+
         void createOePin ( QString d, QString id ) { setOePin( createPin( d, id ) ); }
         void setOePin( IoPin* pin );
         void enableOutputs( bool en );
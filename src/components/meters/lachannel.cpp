@@ -4,6 +4,7 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include "lachannel.h"
+#include "capturestore.h"
 #include "plotdisplay.h"
 #include "simulator.h"
 #include "pin.h"
@@ -26,6 +27,7 @@ void LaChannel::initialize()
     m_bufferCounter = 0;
     m_buffer.fill(0);
     m_time.fill(0);
+    resetPyramid();
 
     updateStep();
 
@@ -61,12 +63,21 @@ void LaChannel::registerEnode( eNode* enode, int n )
     m_busNodes[n] = enode;
 }
 
+int LaChannel::busWidth()
+{
+    int width = 0;
+    for( int n : m_busNodes.keys() ) if( n >= width ) width = n+1;
+    if( width == 0 ) width = 8;
+    return width;
+}
+
 void LaChannel::addReading( double v )
 {
     uint64_t simTime = Simulator::self()->circTime();
     if( ++m_bufferCounter >= m_buffer.size() ) m_bufferCounter = 0;
     m_buffer[m_bufferCounter] = v;
     m_time[m_bufferCounter] = simTime;
+    if( m_capture ) m_capture->addSample( simTime, v );
 }
 
 void LaChannel::voltChanged()
@@ -29,6 +29,7 @@ class LaChannel : public DataChannel
 
         virtual void setIsBus( bool b ) override;
         void registerEnode( eNode* enode, int n=-1 );
+        int busWidth();
 
     private:
         void addReading( double v );
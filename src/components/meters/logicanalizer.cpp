@@ -4,6 +4,7 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <QGraphicsProxyWidget>
+#include <queue>
 
 #include "logicanalizer.h"
 #include "itemlibrary.h"
@@ -78,6 +79,7 @@ LAnalizer::LAnalizer( QString type, QString id )
         m_dataWidget->setColor( i, m_color[i%4] );
     }
     m_updtCount = 0;
+    m_exportAll = false;
     m_thresholdR = 0;
     m_thresholdF = 0;
 
@@ -98,6 +100,9 @@ LAnalizer::LAnalizer( QString type, QString id )
 
         new BoolProp<LAnalizer>("AutoExport", tr("Export at pause"),""
                                , this, &LAnalizer::autoExport, &LAnalizer::setAutoExport ),
+
+        new BoolProp<LAnalizer>("ExportAll", tr("Export full capture"),""
+                               , this, &LAnalizer::exportAll, &LAnalizer::setExportAll ),
     },0} );
 
     addPropGroup( { "Hidden1", {
@@ -123,6 +128,8 @@ LAnalizer::~LAnalizer()
 
 void LAnalizer::updateStep()
 {
+    for( int i=0; i<8; i++ ) m_channel[i]->commitData();
+
     if( !Simulator::self()->isPaused() )
     {
         uint64_t simTime = Simulator::self()->circTime(); // free running
@@ -162,7 +169,7 @@ void LAnalizer::updateStep()
             }
             m_channel[i]->m_connected = connected;
             if( !connected ) m_channel[i]->initialize();
-            m_channel[i]->m_trigIndex = m_channel[i]->m_bufferCounter;
+            m_channel[i]->setTrigIndex( m_channel[i]->m_bufferCounter );
         }
         m_risEdge = 0;
     }
@@ -314,101 +321,115 @@ void LAnalizer::setTunnels( QString tunnels )
         m_dataWidget->setTunnel( i, list.at(i) );
 }   }
 
-void LAnalizer::dumpData( const QString &fn )
+void LAnalizer::dumpData( const QString &fn ) // Streaming k-way merge of all channels
 {
-    QChar identifiers[8] = {'*', '"', '#', '$', '%', '&', '(', ')'};
-
-    QFile file(fn);
+    QFile file( fn );
     if( !file.open( QIODevice::WriteOnly | QIODevice::Text ) ) return;
     m_exportFile = fn;
 
-    QTextStream out( &file );
-    out.setLocale( QLocale::C );
-
-    QMultiMap<uint64_t, sample_t> samples; // collect timing data, use QMap to implicitely sort it
+    uint64_t startTime, endTime;
+    if( m_exportAll ){
+        startTime = 1;
+        endTime = Simulator::self()->circTime();
+    }else{
+        startTime = m_display->startTime();
+        if( (int64_t)startTime+m_timePos >= 0 ) startTime += m_timePos;
+        else                                    startTime  = 1;
+        endTime = m_display->endTime()+m_timePos;
+    }
+    if( m_timeStep < 1 ) m_timeStep = 1;
 
-    uint64_t startTime = m_display->startTime();
-    if( (int64_t)startTime+m_timePos >= 0 ) startTime += m_timePos;
-    else                                    startTime  = 1;
+    QByteArray out;
+    out.append("$timescale "+QByteArray::number( m_timeStep )+"ps $end\n\n");
+    out.append("$scope module "+idLabel().replace(" ","_").toUtf8()+" $end\n");
 
-    uint64_t endTime = m_display->endTime()+m_timePos;
-    uint64_t lastTime = (endTime-startTime)/m_timeStep;
-    uint64_t pTime = 0;
-    double pVal=-1;
+    std::vector<SampleCursor*> cursors( m_numChannels, nullptr );
+    std::vector<double> lastVal( m_numChannels, -1 );
+    std::vector<int> width( m_numChannels, 1 );
+    QByteArray dumpVars = "$dumpvars\n";
 
-    QString varDef;
-    QString dumpVars = "\n$dumpvars\n";
-    uint64_t gcd = 1;  // Problems in Pulseview using gcd
+    typedef std::pair<uint64_t, int> event_t; // Time, channel
+    std::priority_queue<event_t, std::vector<event_t>, std::greater<event_t>> events;
 
-    for( uint ch=0; ch<8; ++ch )
+    for( int ch=0; ch<m_numChannels; ++ch )
     {
         if( !m_channel[ch]->m_connected ) continue;
 
         QString name = m_channel[ch]->getChName();             // Get channel name
         if( name.isEmpty() ) name = "D"+QString::number( ch ); // If name is empty set name = Dn
+        name.replace(" ","_");
 
-        varDef += "$var wire 1 " + QString( identifiers[ch] )+" "+name+" $end\n";
+        if( m_channel[ch]->isBus() ){
+            width[ch] = static_cast<LaChannel*>( m_channel[ch] )->busWidth();
+            out.append("$var wire "+QByteArray::number( width[ch] )+" "+vcdId( ch ).toUtf8()
+                      +" "+name.toUtf8()+" [" +QByteArray::number( width[ch]-1 )+":0] $end\n");
+        }
+        else out.append("$var wire 1 "+vcdId( ch ).toUtf8()+" "+name.toUtf8()+" $end\n");
 
-        bool init = false;
-        double initVal = 0;
-        int index = m_channel[ch]->m_bufferCounter; // Start with the first sample (circular buffer)
+        SampleCursor* cursor = new SampleCursor( m_channel[ch] );
+        cursors[ch] = cursor;
 
-        for( int i=0; i<m_bufferSize; ++i )
+        double initVal = 0;
+        while( cursor->valid() && cursor->time() <= startTime ) // Previous value from first valid sample
         {
-            index++;
-            if( index >= m_bufferSize ) index -= m_bufferSize; // It's a circular buffer
-
-            double   val  = m_channel[ch]->m_buffer[index];
-            uint64_t time = m_channel[ch]->m_time[index];
-
-            if( pTime == time ) continue;                      // Avoid repeated times
-            pTime = time;
-
-            if( time == 0 ) continue;                            // Empty samples: Simulation times start at 1 ps
-            if( time <= startTime ) { initVal = val; continue; } // Previous value from first valid sample
-            if( time > endTime ) { time = endTime; val = pVal; } // Add final value (screen edge)
-            if( !init ) {
-                dumpVars += QString::number(initVal)+identifiers[ch]+"\n"; // Add initial value
-                init = true;
-            }
-            pVal = val;
-            time = (time-startTime)/m_timeStep;
-
-            //if( gcd > 0 ) gcd = getGcd( gcd, time ); // Get Greatest Common Denominator
-            //else          gcd = time;
-
-            samples.insert( time, { val, ch } );
-            if( time == lastTime ) break;            // All samples before endTime already registered
+            initVal = cursor->value();
+            cursor->next();
         }
-    }
-    dumpVars += "$end\n";
-    //if( gcd < 1 ) gcd = 1; // This should not happen
+        lastVal[ch] = initVal;
+        dumpVars.append( vcdValue( initVal, width[ch] ).toUtf8()+vcdId( ch ).toUtf8()+"\n" );
 
-    out <<"$timescale "<< gcd*m_timeStep <<"ps $end"<< endl<< endl;
-    out << varDef;
-    out << endl <<"$enddefinitions $end"<< endl;
-    out << dumpVars;
+        if( cursor->valid() && cursor->time() <= endTime ) events.push( { cursor->time(), ch } );
+    }
+    out.append("$upscope $end\n");
+    out.append("$enddefinitions $end\n\n");
+    out.append( dumpVars );
+    out.append("$end\n");
 
-    uint64_t timeStamp;
-    for( uint64_t time : samples.uniqueKeys() )
+    uint64_t lastStamp = 0;
+    while( !events.empty() )
     {
-        timeStamp = time/gcd;
-        out << endl <<"#"<< timeStamp;
-        for( sample_t sample : samples.values( time ) )
-            out <<" "<< sample.value <<identifiers[sample.channel];
+        event_t event = events.top();
+        events.pop();
+        int ch = event.second;
+        SampleCursor* cursor = cursors[ch];
+
+        double val = cursor->value();
+        cursor->next();
+        if( cursor->valid() && cursor->time() <= endTime ) events.push( { cursor->time(), ch } );
+
+        if( val == lastVal[ch] ) continue;
+        lastVal[ch] = val;
+
+        uint64_t stamp = (event.first-startTime)/m_timeStep;
+        if( stamp != lastStamp ){
+            out.append("#"+QByteArray::number( (qulonglong)stamp )+"\n");
+            lastStamp = stamp;
+        }
+        out.append( vcdValue( val, width[ch] ).toUtf8()+vcdId( ch ).toUtf8()+"\n" );
+
+        if( out.size() > 1<<16 ) { file.write( out ); out.clear(); }
     }
-    out << endl <<"#"<< timeStamp+1; // last time stamp
+    uint64_t endStamp = (endTime-startTime)/m_timeStep;
+    if( endStamp <= lastStamp ) endStamp = lastStamp+1;
+    out.append("#"+QByteArray::number( (qulonglong)endStamp )+"\n"); // last time stamp
+    file.write( out );
     file.close();
+
+    for( SampleCursor* cursor : cursors ) delete cursor;
+}
+
+QString LAnalizer::vcdId( int n ) // Printable ASCII identifiers: ! to ~
+{
+    QString id;
+    do{
+        id.append( QChar( '!'+n%94 ) );
+        n /= 94;
+    }while( n );
+    return id;
 }
 
-uint64_t LAnalizer::getGcd( uint64_t a, uint64_t b )  // Greatest Common Denominator
+QString LAnalizer::vcdValue( double val, int width )
 {
-    uint64_t h;
-    do {
-        h = a % b;
-        a = b;
-        b = h;
-    } while (b != 0);
-
-    return a;
+    if( width == 1 ) return (val > 0) ? "1" : "0";
+    return "b"+QString::number( (qulonglong)val, 2 )+" ";
 }
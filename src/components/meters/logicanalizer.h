@@ -13,11 +13,6 @@ class LaChannel;
 class LaWidget;
 class DataLaWidget;
 
-struct sample_t{
-    double value;
-    uint channel;
-};
-
 class LAnalizer : public PlotBase
 {
     public:
@@ -63,10 +58,16 @@ class LAnalizer : public PlotBase
 
         virtual void expand( bool e ) override;
 
+        bool exportAll() { return m_exportAll; }
+        void setExportAll( bool e ) { m_exportAll = e; }
+
         virtual void dumpData( const QString& fn ) override;
 
     private:
-        uint64_t getGcd( uint64_t a, uint64_t b ); // greatest Common Denominator
+        QString vcdId( int n );
+        QString vcdValue( double val, int width );
+
+        bool m_exportAll;
 
         double m_voltDiv;
         double m_thresholdR;
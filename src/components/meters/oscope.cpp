@@ -56,12 +56,14 @@ Oscope::Oscope( QString type, QString id )
     m_inPin.resize(5);
     m_pin.resize(5);
     m_pin[4] = m_inPin[4] = new IoPin( 180, QPoint(-80-8, 64 ), id+"-PinG", 0, this, input );
+    m_inPin[4]->setAnalogIn( true );
 
     for( int i=0; i<4; i++ )
     {
         m_pin[i] = m_inPin[i] = new IoPin( 180, QPoint(-80-8,-48+32*i ), id+"-Pin"+QString::number(i), 0, this, undef_mode );
         double admit = m_connectGnd ? m_inputAdmit : 0;
         m_inPin[i]->setInputAdmit( admit );
+        m_inPin[i]->setAnalogIn( true );
         m_channel[i] = new OscopeChannel( this, id+"Chan"+QString::number(i) );
         m_channel[i]->m_channel = i;
         m_channel[i]->m_ePin[0] = m_pin[i];
@@ -117,6 +119,8 @@ void Oscope::updateStep()
     uint64_t timeFrame = m_timeDiv*10;
     uint64_t simTime;
 
+    for( int i=0; i<4; i++ ) m_channel[i]->commitData();
+
     if( !Simulator::self()->isPaused() )
     {
         if( m_trigger < 4  ) period = m_channel[m_trigger]->m_period; // We want a trigger
@@ -155,7 +159,7 @@ void Oscope::updateStep()
             }
             m_channel[i]->m_connected = connected;
             if( connected ) m_channel[i]->updateStep();
-            m_channel[i]->m_trigIndex = m_channel[i]->m_bufferCounter;
+            m_channel[i]->setTrigIndex( m_channel[i]->m_bufferCounter );
         }
     }
     m_display->update();
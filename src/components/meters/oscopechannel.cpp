@@ -4,6 +4,7 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include "oscopechannel.h"
+#include "capturestore.h"
 #include "oscope.h"
 #include "plotdisplay.h"
 #include "datawidget.h"
@@ -45,6 +46,7 @@ void OscopeChannel::initialize()
 
     m_buffer.fill(0);
     m_time.fill(0);
+    resetPyramid();
 
     updateStep();
 }
@@ -149,6 +151,7 @@ void OscopeChannel::voltChanged()
     }
     m_buffer[m_bufferCounter] = data;
     m_time[m_bufferCounter] = simTime;
+    if( m_capture ) m_capture->addSample( simTime, data );
 
     if( delta > m_filter )               // Rising
     {
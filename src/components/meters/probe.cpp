@@ -48,6 +48,7 @@ Probe::Probe( QString type, QString id )
     m_pin[0] = m_inputPin = new IoPin( 180, QPoint(-22,0), id+"-inpin", 0, this, undef_mode );
     m_inputPin->setBoundingRect( QRect(-1, -1, 2, 2) );
     m_inputPin->setImpedance( 1e9 );
+    m_inputPin->setAnalogIn( true );
 
     setValLabelPos( 16, 0, 45 ); // x, y, rot
     setShowVal( true );
@@ -24,6 +24,7 @@ class Probe : public Component, public eElement
         virtual void updateStep() override;
 
         void setVolt( double volt );
+        double voltIn() { return m_voltIn; }
 
         void setSmall( bool s );
         bool isSmall() { return m_small; }
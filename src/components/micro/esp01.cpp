@@ -12,6 +12,7 @@
 #include "itemlibrary.h"
 #include "serialmon.h"
 #include "simulator.h"
+#include "circuitwidget.h"
 #include "usarttx.h"
 #include "usartrx.h"
 #include "iopin.h"
@@ -426,7 +427,7 @@ void Esp01::setIdLabel( QString id )
 
 void Esp01::slotOpenTerm()
 {
-    openMonitor( idLabel(), 0 );
+    openMonitor( CircuitWidget::self(), idLabel(), 0 );
 }
 
 void Esp01::setSerialMon( bool s )
@@ -12,6 +12,7 @@
 #include "itemlibrary.h"
 #include "simulator.h"
 #include "circuit.h"
+#include "circuitwidget.h"
 #include "usarttx.h"
 #include "usartrx.h"
 #include "iopin.h"
@@ -231,7 +232,7 @@ void SerialPort::setIdLabel( QString id )
 
 void SerialPort::slotOpenTerm()
 {
-    openMonitor( idLabel(), 0 );
+    openMonitor( CircuitWidget::self(), idLabel(), 0 );
 }
 
 void SerialPort::setSerialMon( bool s )
@@ -12,6 +12,7 @@
 #include "itemlibrary.h"
 #include "simulator.h"
 #include "circuit.h"
+#include "circuitwidget.h"
 #include "usarttx.h"
 #include "usartrx.h"
 #include "iopin.h"
@@ -171,7 +172,7 @@ void SerialTerm::setIdLabel( QString id )
 
 void SerialTerm::slotOpenTerm()
 {
-    openMonitor( idLabel(), 0, /*send=*/true );
+    openMonitor( CircuitWidget::self(), idLabel(), 0, /*send=*/true );
     m_monitor->activateSend();
 }
 
@@ -39,6 +39,7 @@ TestUnit::TestUnit( QString type, QString id )
     m_height = 4;
 
     m_testing = false;
+    m_result  = -1;
 
     m_period = 1e-7; // 100 ns
     m_truthTable = nullptr;
@@ -82,6 +83,7 @@ void TestUnit::stamp()
 
     m_read = false;
     m_changed = false;
+    m_result  = -1;
 
     updtData();
 
@@ -136,6 +138,7 @@ void TestUnit::createTable()
     bool testOk = m_truthTable->setup( m_inputStr, m_outputStr, &m_samples, &m_truthT );
     m_testing = !(m_truthT.size() == 0);
     if( m_testing ) {
+        m_result = testOk ? 1 : 0;
         if( BatchTest::isRunning() ) BatchTest::testCompleted( this, testOk );
     }
     else m_truthT = m_samples; // save samples as truth
@@ -40,6 +40,7 @@ class TestUnit: public IoComponent, public eElement
         void save();
 
         void runTest();
+        int testResult() { return m_result; } // -1: not completed, 0: failed, 1: passed
 
         void loadTest();
 
@@ -50,6 +51,7 @@ class TestUnit: public IoComponent, public eElement
         double m_period;
 
         bool m_testing;
+        int  m_result;
         bool m_read;
         int m_steps;
 
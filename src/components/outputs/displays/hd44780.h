@@ -23,6 +23,7 @@ class Hd44780 : public Hd44780_Base, public eElement
 
         virtual void initialize() override;
         virtual void stamp() override;
+        virtual bool unsavedState() override { return true; }
         virtual void updateStep() override;
         virtual void voltChanged() override;
 
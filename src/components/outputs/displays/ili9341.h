@@ -23,6 +23,7 @@ class Ili9341 : public Component, public eClockedDevice
 
         virtual void stamp() override;
         virtual void initialize() override;
+        virtual bool unsavedState() override { return true; }
         virtual void voltChanged() override;
         virtual void updateStep() override;
         
@@ -23,6 +23,7 @@ class Ks0108 : public Component, public eElement
 
         virtual void initialize() override;
         virtual void stamp() override;
+        virtual bool unsavedState() override { return true; }
         virtual void updateStep() override;
         virtual void voltChanged() override;
 
@@ -33,6 +33,7 @@ class Pcd8544 : public Component, public eElement
         
         virtual void stamp() override;
         virtual void initialize() override;
+        virtual bool unsavedState() override { return true; }
         virtual void voltChanged() override;
         virtual void updateStep() override;
         
@@ -29,6 +29,7 @@ class Max72xx_matrix : public LogicComponent
 
         virtual void stamp() override;
         virtual void initialize() override;
+        virtual bool unsavedState() override { return true; }
         virtual void voltChanged() override;
         virtual void updateStep() override;
 
@@ -42,6 +42,7 @@ class WS2812 : public Component, public eClockedDevice
         void setT1L( int t1l ) { m_T1L = t1l; }
 
         virtual void initialize() override;
+        virtual bool unsavedState() override { return true; }
         virtual void updateStep() override;
         virtual void voltChanged() override;
 
@@ -101,7 +101,6 @@ void Servo::updateStep()
 
         if( absDeltaPos > maxMove ) deltaPos = absDeltaPos/deltaPos*maxMove; // keep sign of deltaPos
         m_pos += deltaPos;
-        Circuit::self()->update();
     }
     m_lastUpdate = step;
     update();
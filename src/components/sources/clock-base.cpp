@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "clock-base.h"
 #include "iopin.h"
 #include "simulator.h"
@@ -50,16 +52,34 @@ void ClockBase::updateStep()
     m_changed = false;
 
     Simulator::self()->cancelEvents( this );
+    Simulator::self()->remPeriodic( this );
     m_outpin->setOutState( false );
     m_state = false;
 
     if( m_isRunning )
     {
         m_lastTime = Simulator::self()->circTime();
-        Simulator::self()->addEvent( 1, this );
+        startEvents();
     }
 }
 
+void ClockBase::saveState( QDataStream& out )
+{
+    out << m_state << m_changed << (quint64)m_lastTime << m_remainder;
+}
+
+void ClockBase::loadState( QDataStream& in ) // Events are restored by Simulator
+{
+    quint64 lastTime;
+    in >> m_state >> m_changed >> lastTime >> m_remainder;
+    m_lastTime = lastTime;
+}
+
+void ClockBase::startEvents()
+{
+    Simulator::self()->addEvent( 1, this );
+}
+
 void ClockBase::setAlwaysOn( bool on )
 {
     m_alwaysOn = on;
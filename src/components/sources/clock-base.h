@@ -19,6 +19,9 @@ class ClockBase : public FixedVolt
         virtual void stamp() override;
         virtual void updateStep() override;
 
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
+
         bool alwaysOn() { return m_alwaysOn; }
         void setAlwaysOn( bool on );
 
@@ -38,6 +41,8 @@ class ClockBase : public FixedVolt
         virtual void onbuttonclicked() override;
 
     protected:
+        virtual void startEvents();
+
         bool m_state;
         bool m_isRunning;
         bool m_alwaysOn;
@@ -46,16 +46,17 @@ Clock::Clock( QString type, QString id )
 }
 Clock::~Clock(){}
 
+void Clock::startEvents() // Clocks with same frequency share one periodic event
+{
+    Simulator::self()->addPeriodic( m_fstepsPC/2, 1, this );
+}
+
 void Clock::runEvent()
 {
+    if( !m_isRunning ) { Simulator::self()->remPeriodic( this ); return; }
+
     m_state = !m_state;
     m_outpin->setOutState( m_state );
-
-    m_remainder += m_fstepsPC-(double)m_stepsPC;
-    uint64_t remainerInt = m_remainder;
-    m_remainder -= remainerInt;
-
-    if( m_isRunning ) Simulator::self()->addEvent( m_stepsPC/2+remainerInt, this );
 }
 
 void Clock::paint( QPainter* p, const QStyleOptionGraphicsItem* o, QWidget* w )
@@ -22,6 +22,9 @@ class Clock : public ClockBase
         virtual void runEvent() override;
 
         virtual void paint( QPainter* p, const QStyleOptionGraphicsItem* o, QWidget* w ) override;
+
+    protected:
+        virtual void startEvents() override;
 };
 
 #endif
@@ -0,0 +1,66 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QFileInfo>
+#include <QFileDialog>
+#include <QMenu>
+#include <QDir>
+#include <QDebug>
+
+#include "filesource-base.h"
+#include "circuitwidget.h"
+#include "simulator.h"
+#include "circuit.h"
+
+#define tr(str) simulideTr("FileSourceBase",str)
+
+FileSourceBase::FileSourceBase( QString type, QString id, QString fileFilter )
+              : IoComponent( type, id )
+              , eElement( id )
+{
+    m_fileFilter = fileFilter;
+}
+FileSourceBase::~FileSourceBase(){}
+
+void FileSourceBase::contextMenu( QGraphicsSceneContextMenuEvent* event, QMenu* menu )
+{
+    QAction* loadAction = menu->addAction( QIcon(":/load.svg"),tr("Load File") );
+    QObject::connect( loadAction, &QAction::triggered, [=](){ slotLoad(); } );
+
+    menu->addSeparator();
+    Component::contextMenu( event, menu );
+}
+
+void FileSourceBase::slotLoad()
+{
+    const QString dir = Circuit::self()->getFilePath();
+
+    QString fileName = QFileDialog::getOpenFileName( 0l, tr("Load File"), dir,
+                       m_fileFilter+";;"+tr("All files (*.*)") );
+
+    if( fileName.isEmpty() ) return; // User cancels loading
+
+    QDir circuitDir = QFileInfo( Circuit::self()->getFilePath() ).absoluteDir();
+    setFile( circuitDir.relativeFilePath( fileName ) );
+}
+
+void FileSourceBase::setFile( QString fileName )
+{
+    if( Simulator::self()->isRunning() ) CircuitWidget::self()->powerCircOff();
+
+    m_fileName = fileName;
+    closeFile();
+    if( fileName.isEmpty() ) return;
+
+    QDir circuitDir = QFileInfo( Circuit::self()->getFilePath() ).absoluteDir();
+    QString fileNameAbs = circuitDir.absoluteFilePath( fileName );
+
+    if( !QFileInfo::exists( fileNameAbs ) )
+    {
+        qDebug() << m_type+"::setFile Error: file doesn't exist:\n"<<fileNameAbs<<"\n";
+        return;
+    }
+    if( !openFile( fileNameAbs ) ) closeFile();
+}
@@ -0,0 +1,37 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef FILESOURCEBASE_H
+#define FILESOURCEBASE_H
+
+#include "iocomponent.h"
+#include "e-element.h"
+
+// Sources driven by a file: "File" property, path relative to circuit
+// and "Load File" context menu. Derived classes read the file.
+
+class FileSourceBase : public IoComponent, public eElement
+{
+    public:
+        FileSourceBase( QString type, QString id, QString fileFilter );
+        ~FileSourceBase();
+
+        QString fileName() { return m_fileName; }
+        void setFile( QString fileName );
+
+        void slotLoad();
+
+        virtual bool unsavedState() override { return true; } // File position is not saved
+        virtual void contextMenu( QGraphicsSceneContextMenuEvent* event, QMenu* menu ) override;
+
+    protected:
+        virtual bool openFile( QString fileNameAbs )=0;
+        virtual void closeFile()=0;
+
+        QString m_fileName;
+        QString m_fileFilter; // File dialog filter
+};
+
+#endif
@@ -0,0 +1,228 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QTextStream>
+#include <QFile>
+#include <QDebug>
+#include <algorithm>
+
+#include "filesource.h"
+#include "itemlibrary.h"
+#include "simulator.h"
+#include "iopin.h"
+
+#include "stringprop.h"
+
+#define tr(str) simulideTr("FileSource",str)
+
+Component* FileSource::construct( QString type, QString id )
+{ return new FileSource( type, id ); }
+
+LibraryItem* FileSource::libraryItem()
+{
+    return new LibraryItem(
+        tr("File Source"),
+        "Sources",
+        "wavegen.png",
+        "FileSource",
+        FileSource::construct );
+}
+
+FileSource::FileSource( QString type, QString id )
+          : FileSourceBase( type, id, tr("VCD files (*.vcd)") )
+{
+    m_width  = 4;
+    m_height = 4;
+    m_index  = 0;
+
+    setNumOuts( 1, "O" );
+
+    addPropGroup( { tr("Main"), {
+        new StrProp<FileSource>("File", tr("File"),""
+                               , this, &FileSource::fileName, &FileSource::setFile, propNoCopy ),
+    },0} );
+
+    addPropGroup( { tr("Electric"), IoComponent::outputProps()
+                                  + IoComponent::outputType(),0 } );
+
+    addPropGroup( { tr("Timing"), IoComponent::edgeProps(),0 } );
+}
+FileSource::~FileSource(){}
+
+void FileSource::stamp()
+{
+    IoComponent::initState();
+
+    m_index = 0;
+    while( m_index < m_changes.size() && m_changes[m_index].time == 0 ) // Initial values
+    {
+        change_t change = m_changes[m_index++];
+        setPinState( change.pin, change.state );
+    }
+    if( m_index < m_changes.size() )
+        Simulator::self()->addEvent( m_changes[m_index].time, this );
+}
+
+void FileSource::runEvent()
+{
+    uint64_t time = m_changes[m_index].time;
+
+    while( m_index < m_changes.size() && m_changes[m_index].time == time ) // All changes at this time
+    {
+        change_t change = m_changes[m_index++];
+        setPinState( change.pin, change.state );
+    }
+    if( m_index < m_changes.size() )
+        Simulator::self()->addEvent( m_changes[m_index].time-time, this );
+}
+
+void FileSource::setPinState( uint pin, uint8_t state )
+{
+    if( pin >= m_outPin.size() ) return;
+    IoPin* ioPin = m_outPin[pin];
+
+    if( state > 1 ) { ioPin->setStateZ( true ); return; }
+    ioPin->setStateZ( false );
+    ioPin->setOutState( state );
+}
+
+bool FileSource::loadVcd( QString fileNameAbs )
+{
+    QFile file( fileNameAbs );
+    if( !file.open( QFile::ReadOnly | QFile::Text ) )
+    {
+        qDebug() << "FileSource::loadVcd Could not open:\n" << fileNameAbs<<"\n";
+        return false;
+    }
+    QTextStream in( &file );
+
+    struct var_t{
+        uint pin;   // First pin
+        uint width;
+    };
+    QHash<QString, var_t> vars;
+    QStringList labels;
+    std::vector<uint8_t> lastState;
+
+    uint64_t timeScale = 1; // Picoseconds per time unit
+    uint64_t timeDiv   = 1; // Time unit lower than 1 ps: fs, timeScale/timeDiv ps per unit
+    uint64_t time = 0;
+    bool rounded = false;
+
+    QString keyword;     // Current $keyword until $end
+    QStringList keyArgs;
+
+    while( !in.atEnd() )
+    {
+        QStringList tokens = in.readLine().simplified().split(" ");
+        for( int t=0; t<tokens.size(); ++t )
+        {
+            QString token = tokens.at(t);
+            if( token.isEmpty() ) continue;
+
+            if( !keyword.isEmpty() ) // Inside a declaration
+            {
+                if( token != "$end" ) { keyArgs.append( token ); continue; }
+
+                if( keyword == "$timescale" )
+                {
+                    QString ts = keyArgs.join("");
+                    int i = 0;
+                    while( i < ts.size() && ts.at(i).isDigit() ) i++;
+                    timeScale = ts.left( i ).toULongLong();
+                    if( timeScale == 0 ) timeScale = 1;
+                    QString unit = ts.mid( i );
+                    timeDiv = 1;
+                    if     ( unit == "fs" ) timeDiv = 1000;
+                    else if( unit == "ns" ) timeScale *= 1000;
+                    else if( unit == "us" ) timeScale *= 1000000;
+                    else if( unit == "ms" ) timeScale *= 1000000000;
+                    else if( unit == "s"  ) timeScale *= 1000000000000;
+                }
+                else if( keyword == "$var" && keyArgs.size() >= 4 ) // type width id name [range]
+                {
+                    uint width = keyArgs.at(1).toUInt();
+                    if( width == 0 ) width = 1;
+                    QString name = keyArgs.at(3);
+                    uint pin = labels.size();
+
+                    vars[keyArgs.at(2)] = { pin, width };
+                    for( uint i=0; i<width; ++i )
+                        labels.append( (width == 1) ? name : name+"["+QString::number(i)+"]" );
+                    lastState.resize( labels.size(), 3 );
+                }
+                keyword.clear();
+                keyArgs.clear();
+                continue;
+            }
+            QChar c = token.at(0);
+            if( c == '$' )
+            {
+                if( token == "$dumpvars" || token == "$dumpall"
+                 || token == "$dumpon"   || token == "$dumpoff"
+                 || token == "$end" ) continue;   // Value changes follow
+                keyword = token;
+                continue;
+            }
+            if( c == '#' )
+            {
+                time = token.mid( 1 ).toULongLong()*timeScale;
+                if( timeDiv > 1 )                       // Round to nearest ps
+                {
+                    if( time % timeDiv ) rounded = true;
+                    time = (time+timeDiv/2)/timeDiv;
+                }
+                continue;
+            }
+
+            QString id;
+            QString value;
+            if( c == 'b' || c == 'B' || c == 'r' || c == 'R' ) // Vector or real: value id
+            {
+                if( ++t >= tokens.size() ) break;
+                value = token.mid( 1 );
+                id = tokens.at(t);
+                if( c == 'r' || c == 'R' ) value = (value.toDouble() > 0) ? "1" : "0";
+            }else{                                                // Scalar: value+id
+                value = c;
+                id = token.mid( 1 );
+            }
+            if( !vars.contains( id ) ) continue;
+            var_t var = vars.value( id );
+
+            QChar ext = value.at(0).toLower(); // Left extension: 0 unless x or z
+            if( ext != 'x' && ext != 'z' ) ext = '0';
+
+            for( uint i=0; i<var.width; ++i ) // LSB is last char
+            {
+                int pos = value.size()-1-i;
+                QChar bit = (pos >= 0) ? value.at( pos ).toLower() : ext;
+                uint8_t state = 0;
+                if     ( bit == '1' ) state = 1;
+                else if( bit == 'z' ) state = 2;          // x is read as 0
+
+                uint pin = var.pin+i;
+                if( lastState[pin] == state ) continue;   // Only schedule changes
+                lastState[pin] = state;
+                m_changes.push_back( { time, pin, state } );
+    }   }   }
+    file.close();
+
+    if( labels.isEmpty() )
+    {
+        qDebug() << "FileSource::loadVcd Error: no signals found in:\n" << fileNameAbs<<"\n";
+        return false;
+    }
+    if( rounded ) qDebug() << "FileSource::loadVcd Warning: times lower than 1 ps rounded to nearest ps in:\n" << fileNameAbs<<"\n";
+
+    std::stable_sort( m_changes.begin(), m_changes.end()
+                    , []( const change_t& a, const change_t& b ){ return a.time < b.time; } );
+
+    if( (int)m_outPin.size() != labels.size() ) setNumOuts( labels.size(), "O" );
+    for( int i=0; i<labels.size(); ++i ) m_outPin[i]->setLabelText( labels.at(i) );
+    updtOutPins();
+
+    return true;
+}
@@ -0,0 +1,43 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef FILESOURCE_H
+#define FILESOURCE_H
+
+#include "filesource-base.h"
+
+class LibraryItem;
+
+class FileSource : public FileSourceBase
+{
+    public:
+        FileSource( QString type, QString id );
+        ~FileSource();
+
+ static Component* construct( QString type, QString id );
+ static LibraryItem* libraryItem();
+
+        virtual void stamp() override;
+        virtual void runEvent() override;
+
+    protected:
+        virtual bool openFile( QString fileNameAbs ) override { return loadVcd( fileNameAbs ); }
+        virtual void closeFile() override { m_changes.clear(); }
+
+    private:
+        struct change_t{
+            uint64_t time; // Picoseconds
+            uint32_t pin;
+            uint8_t  state; // 0, 1 or 2 = High impedance
+        };
+
+        bool loadVcd( QString fileNameAbs );
+        void setPinState( uint pin, uint8_t state );
+
+        std::vector<change_t> m_changes; // Ordered by time
+        uint m_index;
+};
+
+#endif
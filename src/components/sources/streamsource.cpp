@@ -0,0 +1,495 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QFileInfo>
+#include <QtEndian>
+#include <QDebug>
+#include <string.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+
+#include "streamsource.h"
+#include "itemlibrary.h"
+#include "circuitwidget.h"
+#include "simulator.h"
+#include "iopin.h"
+
+#include "doubleprop.h"
+#include "stringprop.h"
+#include "boolprop.h"
+#include "intprop.h"
+
+#define tr(str) simulideTr("StreamSource",str)
+
+Component* StreamSource::construct( QString type, QString id )
+{ return new StreamSource( type, id ); }
+
+LibraryItem* StreamSource::libraryItem()
+{
+    return new LibraryItem(
+        tr("Stream Source"),
+        "Sources",
+        "wavegen.png",
+        "StreamSource",
+        StreamSource::construct );
+}
+
+StreamSource::StreamSource( QString type, QString id )
+            : FileSourceBase( type, id, tr("Stream files (*.wav *.raw *.bin *.csv *.pwl *.txt)") )
+{
+    m_width  = 4;
+    m_height = 4;
+
+    m_map      = nullptr;
+    m_mapSize  = 0;
+    m_fileType = fileNone;
+    m_numChan  = 0;
+    m_ended    = true;
+
+    m_rawFormats = QStringList({"U8","S16","S24","S32","F32","F64"});
+    m_rawFormat   = sampleS16;
+    m_rawChannels = 1;
+    m_rawRate     = 44100;
+
+    m_interpolate = false;
+    m_interpStep  = 1e6; // 1 us
+    m_loop   = false;
+    m_gain   = 1;
+    m_offset = 0;
+
+    setNumOuts( 1, "O" );
+
+    addPropGroup( { tr("Main"), {
+        new StrProp <StreamSource>("File", tr("File"),""
+                                  , this, &StreamSource::fileName, &StreamSource::setFile, propNoCopy ),
+
+        new BoolProp<StreamSource>("Loop", tr("Loop"),""
+                                  , this, &StreamSource::loop, &StreamSource::setLoop ),
+
+        new BoolProp<StreamSource>("Interpolate", tr("Interpolate"),""
+                                  , this, &StreamSource::interpolate, &StreamSource::setInterpolate ),
+
+        new DoubProp<StreamSource>("Interp_Step", tr("Interpolation Step"),"us"
+                                  , this, &StreamSource::interpStep, &StreamSource::setInterpStep ),
+    },0} );
+
+    addPropGroup( { tr("Electric"), {
+        new DoubProp<StreamSource>("Gain", tr("Gain"),"V"
+                                  , this, &StreamSource::gain, &StreamSource::setGain ),
+
+        new DoubProp<StreamSource>("Offset", tr("Offset"),"V"
+                                  , this, &StreamSource::offset, &StreamSource::setOffset ),
+
+        new DoubProp<StreamSource>("Out_Imped", tr("Output Impedance"), "Ω"
+                                  , this, &StreamSource::outImp, &StreamSource::setOutImp )
+    },0} );
+
+    addPropGroup( { tr("Raw File"), {
+        new StrProp <StreamSource>("Raw_Format", tr("Sample Format"), m_rawFormats.join(",")
+                                  , this, &StreamSource::rawFormat, &StreamSource::setRawFormat,0,"enum" ),
+
+        new IntProp <StreamSource>("Channels", tr("Channels"),""
+                                  , this, &StreamSource::channels, &StreamSource::setChannels,0,"uint" ),
+
+        new DoubProp<StreamSource>("Sample_Rate", tr("Sample Rate"),"kHz"
+                                  , this, &StreamSource::sampleRate, &StreamSource::setSampleRate ),
+    },0} );
+}
+StreamSource::~StreamSource()
+{
+    closeFile();
+}
+
+void StreamSource::stamp()
+{
+    IoComponent::initState();
+
+    m_ended = true;
+    if( !m_map ) return;
+
+    m_p0.values.assign( m_numChan, m_offset );
+    m_p1.values.assign( m_numChan, m_offset );
+    m_p0.time = 0;
+
+    m_startTime = Simulator::self()->circTime();
+    m_loopTime  = 0;
+    m_period    = 0;
+    if( m_fileType != fileText ) m_period = llround( (m_dataEnd-m_dataStart)/m_frameSize*m_samplePs );
+
+    rewind();
+    if( !readPoint( &m_p1 ) ) return;
+    m_ended = false;
+    m_p0 = m_p1;
+    nextPoint();
+
+    Simulator::self()->addEvent( 1, this );
+}
+
+void StreamSource::runEvent()
+{
+    uint64_t now = Simulator::self()->circTime()-m_startTime;
+
+    while( !m_ended && m_p1.time <= now ) nextPoint(); // Find segment containing now
+
+    double k = 0;
+    if( m_interpolate && !m_ended && now > m_p0.time )
+        k = (double)(now-m_p0.time)/(double)(m_p1.time-m_p0.time);
+
+    for( uint i=0; i<m_numChan; ++i )
+    {
+        double v0 = m_p0.values[i];
+        m_outPin[i]->setVoltage( v0+(m_p1.values[i]-v0)*k );
+    }
+    if( m_ended ) return;
+
+    uint64_t loopTime  = m_loopTime;
+    uint64_t skipStart = m_p0.time;
+    while( sameValues() )               // Skip points without changes
+    {
+        if( !nextPoint() ) return;
+        if( m_loopTime != loopTime && m_p1.time >= skipStart+m_period ) break; // Whole loop without changes
+    }
+
+    uint64_t next = m_p1.time;
+    if( m_interpolate )
+    {
+        uint64_t base = (now > m_p0.time) ? now : m_p0.time;
+        if( base+m_interpStep < next ) next = base+m_interpStep;
+    }
+    Simulator::self()->addEvent( next-now, this );
+}
+
+bool StreamSource::nextPoint() // Move to next segment
+{
+    std::swap( m_p0, m_p1 );
+    if( readPoint( &m_p1 ) ) return true;
+
+    if( m_fileType == fileText ) m_period = m_p0.time-m_loopTime; // Last point time
+
+    if( m_loop && m_period )
+    {
+        m_loopTime += m_period;
+        rewind();
+        if( readPoint( &m_p1 ) ) return true;
+    }
+    m_p1 = m_p0;     // Hold last value
+    m_ended = true;
+    return false;
+}
+
+bool StreamSource::sameValues()
+{
+    for( uint i=0; i<m_numChan; ++i )
+        if( m_p0.values[i] != m_p1.values[i] ) return false;
+    return true;
+}
+
+void StreamSource::rewind()
+{
+    m_pos   = m_dataStart;
+    m_frame = 0;
+}
+
+bool StreamSource::readPoint( point_t* point )
+{
+    if( m_fileType == fileText ) return readLine( point );
+    return readFrame( point );
+}
+
+bool StreamSource::readFrame( point_t* point )
+{
+    if( m_pos+m_frameSize > m_dataEnd ) return false;
+
+    const uchar* p = m_map+m_pos;
+    for( uint i=0; i<m_numChan; ++i ) point->values[i] = readSample( p+i*m_sampleSize )*m_gain+m_offset;
+
+    point->time = m_loopTime+llround( m_frame*m_samplePs );
+    m_pos += m_frameSize;
+    m_frame++;
+    return true;
+}
+
+inline double StreamSource::readSample( const uchar* p )
+{
+    switch( m_sampleType ) {
+        case sampleU8:  return ((int)p[0]-128)/128.0;
+        case sampleS16: return qFromLittleEndian<qint16>( p )/32768.0;
+        case sampleS24:{
+            int32_t v = p[0] | (p[1]<<8) | (p[2]<<16);
+            if( v & 0x800000 ) v |= 0xFF000000;
+            return v/8388608.0;
+        }
+        case sampleS32: return qFromLittleEndian<qint32>( p )/2147483648.0;
+        case sampleF32:{
+            quint32 v = qFromLittleEndian<quint32>( p );
+            float f; memcpy( &f, &v, 4 );
+            return f;
+        }
+        case sampleF64:{
+            quint64 v = qFromLittleEndian<quint64>( p );
+            double d; memcpy( &d, &v, 8 );
+            return d;
+        }
+    }
+    return 0;
+}
+
+bool StreamSource::readLine( point_t* point ) // Time, value0, value1...
+{
+    while( m_pos < m_dataEnd )
+    {
+        const char* start = (const char*)m_map+m_pos;
+        const char* eol = (const char*)memchr( start, '\n', m_dataEnd-m_pos );
+        qint64 size = eol ? eol-start : m_dataEnd-m_pos;
+        m_pos += size+1;
+
+        QByteArray line = QByteArray( start, size ).simplified();
+        if( line.isEmpty() ) continue;
+        char c = line.at(0);
+        if( c == '#' || c == ';' || c == '*' || c == '/' ) continue; // Comments
+
+        QList<QByteArray> tokens = line.replace(',',' ').replace(';',' ').replace('\t',' ').split(' ');
+        tokens.removeAll( QByteArray() );
+
+        double time;
+        if( tokens.isEmpty() || !parseNumber( tokens.at(0), &time ) || time < 0 ) continue;
+
+        for( uint i=0; i<m_numChan; ++i ) // Missing values keep last value
+        {
+            double value;
+            if( (int)i+1 < tokens.size() && parseNumber( tokens.at( i+1 ), &value ) )
+                point->values[i] = value*m_gain+m_offset;
+            else if( point != &m_p0 )
+                point->values[i] = m_p0.values[i];
+        }
+        point->time = m_loopTime+llround( time*1e12 );
+        if( point != &m_p0 && point->time < m_p0.time ) point->time = m_p0.time; // Not ordered
+        return true;
+    }
+    return false;
+}
+
+bool StreamSource::parseNumber( const QByteArray& token, double* value ) // Spice style suffixes
+{
+    const char* str = token.constData();
+    char* end;
+    double v = strtod( str, &end );
+    if( end == str ) return false;
+
+    switch( tolower( *end ) ) {
+        case 't': v *= 1e12;  break;
+        case 'g': v *= 1e9;   break;
+        case 'k': v *= 1e3;   break;
+        case 'm': v *= (qstrnicmp( end, "meg", 3 ) == 0) ? 1e6 : 1e-3; break;
+        case 'u': v *= 1e-6;  break;
+        case 'n': v *= 1e-9;  break;
+        case 'p': v *= 1e-12; break;
+        case 'f': v *= 1e-15; break;
+    }
+    *value = v;
+    return true;
+}
+
+bool StreamSource::openFile( QString fileNameAbs )
+{
+    m_file.setFileName( fileNameAbs );
+    if( !m_file.open( QFile::ReadOnly ) )
+    {
+        qDebug() << "StreamSource::openFile Could not open:\n" << m_file.fileName()<<"\n";
+        return false;
+    }
+    m_mapSize = m_file.size();
+    if( m_mapSize ) m_map = m_file.map( 0, m_mapSize );
+    if( !m_map )
+    {
+        qDebug() << "StreamSource::openFile Error: Could not map:\n" << m_file.fileName()<<"\n";
+        return false;
+    }
+    QString suffix = QFileInfo( m_file.fileName() ).suffix().toLower();
+    QStringList labels;
+    bool ok;
+    if     ( suffix == "wav" ) { m_fileType = fileWav; ok = openWav(); }
+    else if( suffix == "csv" || suffix == "pwl" || suffix == "txt" )
+    {
+        m_fileType = fileText;
+        ok = openText();
+        if( ok && m_dataStart > 0 ) // Header line: channel names
+        {
+            QByteArray header = QByteArray( (const char*)m_map, m_dataStart ).trimmed();
+            header = header.mid( header.lastIndexOf('\n')+1 ).replace(';',',');
+            for( QByteArray label : header.split(',').mid( 1 ) ) labels.append( QString( label ).trimmed() );
+        }
+    }
+    else { m_fileType = fileRaw; ok = openRaw(); }
+
+    if( !ok ) return false;
+
+    if( m_numChan != m_outPin.size() ) setNumOuts( m_numChan, "O" );
+    for( uint i=0; i<m_numChan; ++i )
+    {
+        QString label = ( (int)i < labels.size() ) ? labels.at(i) : "";
+        if( label.isEmpty() ) label = "Ch"+QString::number( i );
+        m_outPin[i]->setLabelText( label );
+    }
+    updtOutPins();
+    return true;
+}
+
+void StreamSource::closeFile()
+{
+    if( m_map ) m_file.unmap( m_map );
+    if( m_file.isOpen() ) m_file.close();
+    m_map      = nullptr;
+    m_mapSize  = 0;
+    m_fileType = fileNone;
+}
+
+bool StreamSource::openWav()
+{
+    if( m_mapSize < 12 || memcmp( m_map, "RIFF", 4 ) || memcmp( m_map+8, "WAVE", 4 ) )
+    {
+        qDebug() << "StreamSource::openWav Error: Not a WAV file:\n" << m_file.fileName()<<"\n";
+        return false;
+    }
+    uint16_t format = 0;
+    uint16_t bits   = 0;
+    uint32_t rate   = 0;
+    m_numChan   = 0;
+    m_frameSize = 0;
+    m_dataStart = 0;
+
+    qint64 pos = 12;
+    while( pos+8 <= m_mapSize ) // Read chunks
+    {
+        const uchar* chunk = m_map+pos;
+        qint64 size = qFromLittleEndian<quint32>( chunk+4 );
+
+        if( !memcmp( chunk, "fmt ", 4 ) && size >= 16 && pos+8+size <= m_mapSize )
+        {
+            format      = qFromLittleEndian<quint16>( chunk+8 );
+            m_numChan   = qFromLittleEndian<quint16>( chunk+10 );
+            rate        = qFromLittleEndian<quint32>( chunk+12 );
+            m_frameSize = qFromLittleEndian<quint16>( chunk+20 );
+            bits        = qFromLittleEndian<quint16>( chunk+22 );
+            if( format == 0xFFFE && size >= 40 ) format = qFromLittleEndian<quint16>( chunk+32 ); // Extensible
+        }
+        else if( !memcmp( chunk, "data", 4 ) )
+        {
+            m_dataStart = pos+8;
+            m_dataEnd   = std::min( m_dataStart+size, m_mapSize );
+            break;
+        }
+        pos += 8+size+(size & 1);
+    }
+    bool ok = true;
+    if     ( format == 1 && bits == 8  ) m_sampleType = sampleU8;
+    else if( format == 1 && bits == 16 ) m_sampleType = sampleS16;
+    else if( format == 1 && bits == 24 ) m_sampleType = sampleS24;
+    else if( format == 1 && bits == 32 ) m_sampleType = sampleS32;
+    else if( format == 3 && bits == 32 ) m_sampleType = sampleF32;
+    else if( format == 3 && bits == 64 ) m_sampleType = sampleF64;
+    else ok = false;
+
+    m_sampleSize = bits/8;
+    if( !ok || !m_dataStart || !rate || !m_numChan || m_frameSize < m_numChan*m_sampleSize )
+    {
+        qDebug() << "StreamSource::openWav Error: WAV format not supported:\n" << m_file.fileName()<<"\n";
+        return false;
+    }
+    m_samplePs = 1e12/rate;
+    return true;
+}
+
+bool StreamSource::openRaw()
+{
+    static const uint sampleSizes[] = { 1, 2, 3, 4, 4, 8 };
+
+    m_sampleType = (sampleType_t)m_rawFormat;
+    m_sampleSize = sampleSizes[m_rawFormat];
+    m_numChan    = m_rawChannels;
+    m_frameSize  = m_numChan*m_sampleSize;
+    m_samplePs   = 1e12/m_rawRate;
+    m_dataStart  = 0;
+    m_dataEnd    = m_mapSize;
+    return true;
+}
+
+bool StreamSource::openText() // Find header and number of columns
+{
+    m_dataStart = 0;
+    m_dataEnd   = m_mapSize;
+    m_numChan   = 0;
+
+    qint64 pos = 0;
+    while( pos < m_mapSize )
+    {
+        const char* start = (const char*)m_map+pos;
+        const char* eol = (const char*)memchr( start, '\n', m_mapSize-pos );
+        qint64 size = eol ? eol-start : m_mapSize-pos;
+        qint64 lineStart = pos;
+        pos += size+1;
+
+        QByteArray line = QByteArray( start, size ).simplified();
+        if( line.isEmpty() ) continue;
+        char c = line.at(0);
+        if( c == '#' || c == ';' || c == '*' || c == '/' ) continue;
+
+        QList<QByteArray> tokens = line.replace(',',' ').replace(';',' ').replace('\t',' ').split(' ');
+        tokens.removeAll( QByteArray() );
+
+        double time;
+        if( !parseNumber( tokens.at(0), &time ) ) // Header line
+        {
+            m_dataStart = pos;
+            continue;
+        }
+        m_dataStart = lineStart;
+        m_numChan = tokens.size()-1;
+        break;
+    }
+    if( m_numChan == 0 )
+    {
+        qDebug() << "StreamSource::openText Error: No data found in:\n" << m_file.fileName()<<"\n";
+        return false;
+    }
+    return true;
+}
+
+void StreamSource::setRawFormat( QString f )
+{
+    int index = m_rawFormats.indexOf( f );
+    if( index < 0 ) return;
+    m_rawFormat = index;
+    if( m_fileType == fileRaw ) openRaw();
+}
+
+void StreamSource::setChannels( int c )
+{
+    if( c < 1 ) c = 1;
+    if( m_rawChannels == c ) return;
+    m_rawChannels = c;
+    if( m_fileType != fileRaw ) return;
+
+    if( Simulator::self()->isRunning() ) CircuitWidget::self()->powerCircOff();
+    openRaw();
+    setNumOuts( m_numChan, "O" );
+    for( uint i=0; i<m_numChan; ++i ) m_outPin[i]->setLabelText( "Ch"+QString::number( i ) );
+    updtOutPins();
+}
+
+void StreamSource::setSampleRate( double r )
+{
+    if( r <= 0 ) return;
+    m_rawRate = r;
+    if( m_fileType == fileRaw ) openRaw();
+}
+
+void StreamSource::setInterpStep( double s )
+{
+    m_interpStep = s*1e12;
+    if( m_interpStep < 1 ) m_interpStep = 1;
+}
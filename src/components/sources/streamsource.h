@@ -0,0 +1,132 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef STREAMSOURCE_H
+#define STREAMSOURCE_H
+
+#include <QFile>
+
+#include "filesource-base.h"
+
+class LibraryItem;
+
+// Analog stimulus from a recording: WAV, raw binary or CSV/PWL text.
+// File is memory mapped and read point by point while simulating,
+// so file size is not limited by RAM.
+// Each channel drives one output pin, events are only scheduled
+// when some output value changes.
+
+class StreamSource : public FileSourceBase
+{
+    public:
+        StreamSource( QString type, QString id );
+        ~StreamSource();
+
+ static Component* construct( QString type, QString id );
+ static LibraryItem* libraryItem();
+
+        virtual void stamp() override;
+        virtual void runEvent() override;
+
+        QString rawFormat() { return m_rawFormats.at( m_rawFormat ); }
+        void setRawFormat( QString f );
+
+        int channels() { return m_rawChannels; }
+        void setChannels( int c );
+
+        double sampleRate() { return m_rawRate; }
+        void setSampleRate( double r );
+
+        bool interpolate() { return m_interpolate; }
+        void setInterpolate( bool i ) { m_interpolate = i; }
+
+        double interpStep() { return m_interpStep*1e-12; }
+        void setInterpStep( double s );
+
+        bool loop() { return m_loop; }
+        void setLoop( bool l ) { m_loop = l; }
+
+        double gain() { return m_gain; }
+        void setGain( double g ) { m_gain = g; }
+
+        double offset() { return m_offset; }
+        void setOffset( double o ) { m_offset = o; }
+
+    protected:
+        virtual bool openFile( QString fileNameAbs ) override;
+        virtual void closeFile() override;
+
+    private:
+        enum fileType_t{
+            fileNone=0,
+            fileWav,
+            fileRaw,
+            fileText
+        };
+        enum sampleType_t{
+            sampleU8=0,
+            sampleS16,
+            sampleS24,
+            sampleS32,
+            sampleF32,
+            sampleF64
+        };
+        struct point_t{
+            uint64_t time;      // Picoseconds from stream start
+            std::vector<double> values;
+        };
+
+        bool openWav();
+        bool openRaw();
+        bool openText();
+
+        void rewind();
+        bool readPoint( point_t* point );
+        bool readFrame( point_t* point );
+        bool readLine( point_t* point );
+        bool nextPoint();
+        bool sameValues();
+
+        inline double readSample( const uchar* p );
+ static bool parseNumber( const QByteArray& token, double* value );
+
+        QFile   m_file;
+        uchar*  m_map;
+        qint64  m_mapSize;
+
+        fileType_t   m_fileType;
+        sampleType_t m_sampleType;
+
+        qint64   m_dataStart;   // Binary: first frame, Text: first data line
+        qint64   m_dataEnd;
+        qint64   m_pos;         // Read position
+        uint     m_frameSize;   // Binary: bytes per frame
+        uint     m_sampleSize;  // Binary: bytes per sample
+        uint64_t m_frame;       // Binary: frame index
+        double   m_samplePs;    // Binary: picoseconds per frame
+        uint     m_numChan;
+
+        uint64_t m_startTime;   // Simulation time at stream start
+        uint64_t m_loopTime;    // Stream time added in each loop
+        uint64_t m_period;      // Stream duration
+        bool     m_ended;
+
+        point_t m_p0;           // Current segment
+        point_t m_p1;
+
+        QStringList m_rawFormats;
+        int    m_rawFormat;
+        int    m_rawChannels;
+        double m_rawRate;
+
+        bool     m_interpolate;
+        uint64_t m_interpStep;
+        bool     m_loop;
+
+        double m_gain;
+        double m_offset;
+};
+
+#endif
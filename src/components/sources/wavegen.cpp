@@ -172,12 +172,20 @@ void WaveGen::runEvent()
         }
         else m_outpin->setVoltage( m_voltBase+m_voltage*m_vOut );
     }
+    if( !m_isRunning ) { Simulator::self()->remPeriodic( this ); return; }
+    if( isPeriodic() ) return; // Next step already scheduled
+
     m_remainder += m_fstepsPC-(double)m_stepsPC;
     uint64_t remainerInt = m_remainder;
     m_remainder -= remainerInt;
 
-    if( m_isRunning )
-        Simulator::self()->addEvent( m_nextStep+remainerInt, this );
+    Simulator::self()->addEvent( m_nextStep+remainerInt, this );
+}
+
+void WaveGen::startEvents() // Fixed step waves use periodic events
+{
+    if( isPeriodic() ) Simulator::self()->addPeriodic( m_fstepsPC/m_steps, 1, this );
+    else               ClockBase::startEvents();
 }
 
 void WaveGen::genSine()
@@ -239,6 +247,7 @@ void WaveGen::setSteps( int steps )
 
     m_steps = steps;
     m_qSteps  = m_stepsPC/steps;
+    m_changed = true;  // Reschedule events
 }
 
 void WaveGen::setFreq( double freq )
@@ -287,6 +296,7 @@ void WaveGen::setFloating( bool f )
 void WaveGen::setWaveType( QString type )
 {
     m_waveTypeStr = type;
+    m_changed = true;  // Reschedule events
     if( m_showVal && (m_showProperty == "Wave_Type") )
         setValLabelText( type );
 
@@ -69,6 +69,7 @@ class WaveGen : public ClockBase
 
     protected:
         virtual void slotProperties() override;
+        virtual void startEvents() override;
 
     private:
         void genSine();
@@ -79,6 +80,7 @@ class WaveGen : public ClockBase
         void genWav();
 
         void updtProperties();
+        bool isPeriodic() { return m_waveType != Square && m_waveType != Random; }
 
         double normalize( double data );
         
@@ -3,6 +3,7 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QSettings>
 #include <math.h>
 
 #include "appdialog.h"
@@ -31,9 +32,11 @@ AppDialog::AppDialog( QWidget* parent )
     drawGrid->setChecked( Circuit::self()->drawGrid() );
     showScroll->setChecked( CircuitView::self()->showScroll() );
     animate->setChecked( Circuit::self()->animate() );
+    cacheRender->setChecked( Circuit::self()->cacheRender() );
     canvasWidth->setValue( Circuit::self()->sceneWidth() );
     canvasHeight->setValue( Circuit::self()->sceneHeight() );
     fps->setValue( Simulator::self()->fps() );
+    animBudget->setValue( Simulator::self()->animBudget() );
     backup->setValue( Circuit::self()->autoBck() );
     undo_steps->setValue( Circuit::self()->undoSteps() );
 
@@ -61,6 +64,7 @@ AppDialog::AppDialog( QWidget* parent )
 
     nlStepsBox->setValue( Simulator::self()->maxNlSteps() );
     slopeStepsBox->setValue( Simulator::self()->slopeSteps() );
+    collapseSlopesBox->setChecked( Simulator::self()->collapseSlopes() );
     m_blocked = false;
 
     updtSpeedPer();
@@ -145,6 +149,11 @@ void AppDialog::on_animate_toggled( bool ani )
     Circuit::self()->setAnimate( ani );
 }
 
+void AppDialog::on_cacheRender_toggled( bool cache )
+{
+    Circuit::self()->setCacheRender( cache );
+}
+
 void AppDialog::on_canvasWidth_editingFinished()
 {
     Circuit::self()->setSceneWidth( canvasWidth->value() );
@@ -160,6 +169,12 @@ void AppDialog::on_fps_valueChanged( int fps )
     Simulator::self()->setFps( fps );
 }
 
+void AppDialog::on_animBudget_valueChanged( int ms )
+{
+    Simulator::self()->setAnimBudget( ms );
+    MainWindow::self()->settings()->setValue( "Circuit/animBudget", ms );
+}
+
 void AppDialog::on_backup_valueChanged( int secs )
 {
     Circuit::self()->setAutoBck( secs );
@@ -265,6 +280,11 @@ void AppDialog::on_slopeStepsBox_editingFinished()
     Simulator::self()->setSlopeSteps( slopeStepsBox->value() );
 }
 
+void AppDialog::on_collapseSlopesBox_toggled( bool c )
+{
+    Simulator::self()->setCollapseSlopes( c );
+}
+
 void AppDialog::on_fontName_currentFontChanged( const QFont &f )
 {
     MainWindow::self()->setDefaultFontName( f.family() );
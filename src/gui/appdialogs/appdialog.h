@@ -37,9 +37,11 @@ class AppDialog : public QDialog, private Ui::AppDialog
         void on_drawGrid_toggled( bool draw );
         void on_showScroll_toggled( bool show );
         void on_animate_toggled( bool ani );
+        void on_cacheRender_toggled( bool cache );
         void on_canvasWidth_editingFinished();
         void on_canvasHeight_editingFinished();
         void on_fps_valueChanged( int fps );
+        void on_animBudget_valueChanged( int ms );
         void on_backup_valueChanged( int secs );
         void on_undo_steps_valueChanged( int steps );
 
@@ -55,6 +57,7 @@ class AppDialog : public QDialog, private Ui::AppDialog
         void on_reactStepBox_editingFinished();
 
         void on_slopeStepsBox_editingFinished();
+        void on_collapseSlopesBox_toggled( bool c );
 
     private slots:
         void on_fontName_currentFontChanged( const QFont &f );
@@ -0,0 +1,204 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QBoxLayout>
+#include <QFileDialog>
+#include <QMessageBox>
+
+#include "profilerdialog.h"
+#include "simulator.h"
+#include "simtrace.h"
+
+ProfilerDialog::ProfilerDialog( QWidget* parent )
+              : QDialog( parent )
+{
+    setWindowTitle( tr("Simulation Profiler") );
+    resize( 760, 480 );
+
+    m_enable = new QCheckBox( tr("Enable"), this );
+    m_enable->setChecked( Simulator::self()->profiling() );
+    connect( m_enable, &QCheckBox::toggled, [=]( bool p ){ setProfiling( p ); } );
+
+    m_view = new QComboBox( this );
+    m_view->addItems( { tr("By type"), tr("By element"), tr("Matrix groups") } );
+    connect( m_view, QOverload<int>::of( &QComboBox::currentIndexChanged ), [=](int){ updateTable(); } );
+
+    QPushButton* resetButton = new QPushButton( tr("Reset"), this );
+    connect( resetButton, &QPushButton::clicked, [=](){ reset(); } );
+
+    QPushButton* saveButton = new QPushButton( tr("Save..."), this );
+    connect( saveButton, &QPushButton::clicked, [=](){ save(); } );
+
+    m_trace = new QCheckBox( tr("Record trace"), this );
+    m_trace->setChecked( SimTrace::enabled() );
+    connect( m_trace, &QCheckBox::toggled, [=]( bool t ){ setTracing( t ); } );
+
+    QPushButton* traceButton = new QPushButton( tr("Save Trace..."), this );
+    connect( traceButton, &QPushButton::clicked, [=](){ saveTrace(); } );
+
+    QHBoxLayout* topLayout = new QHBoxLayout();
+    topLayout->addWidget( m_enable );
+    topLayout->addWidget( m_view );
+    topLayout->addStretch();
+    topLayout->addWidget( resetButton );
+    topLayout->addWidget( saveButton );
+    topLayout->addSpacing( 20 );
+    topLayout->addWidget( m_trace );
+    topLayout->addWidget( traceButton );
+
+    m_summary = new QLabel( this );
+
+    m_table = new QTableWidget( this );
+    m_table->setEditTriggers( QAbstractItemView::NoEditTriggers );
+    m_table->setSelectionBehavior( QAbstractItemView::SelectRows );
+    m_table->verticalHeader()->setVisible( false );
+    m_table->horizontalHeader()->setSectionResizeMode( QHeaderView::ResizeToContents );
+    m_table->setSortingEnabled( true );
+
+    QVBoxLayout* layout = new QVBoxLayout( this );
+    layout->addLayout( topLayout );
+    layout->addWidget( m_summary );
+    layout->addWidget( m_table );
+
+    m_timer.setInterval( 1000 );
+    connect( &m_timer, &QTimer::timeout, [=](){ updateTable(); } );
+}
+
+void ProfilerDialog::showEvent( QShowEvent* )
+{
+    m_enable->setChecked( Simulator::self()->profiling() );
+    updateTable();
+    m_timer.start();
+}
+
+void ProfilerDialog::hideEvent( QHideEvent* ) { m_timer.stop(); }
+
+void ProfilerDialog::setProfiling( bool p )
+{
+    Simulator::self()->setProfiling( p );
+    updateTable();
+}
+
+void ProfilerDialog::reset()
+{
+    Simulator::self()->profileData()->reset(); // Applied at next Simulator step
+    if( !Simulator::self()->isRunning() )
+        Simulator::self()->profileData()->commit( Simulator::self()->circTime() );
+    updateTable();
+}
+
+void ProfilerDialog::save()
+{
+    QString fileName = QFileDialog::getSaveFileName( this, tr("Save Profile"), "",
+                                                     tr("Text files (*.txt);;All files (*)"));
+    if( fileName.isEmpty() ) return;
+
+    if( !Simulator::self()->profileData()->dump( fileName ) )
+        QMessageBox::warning( this, tr("Save Profile"), tr("Could not save profile to:\n")+fileName );
+}
+
+void ProfilerDialog::setTracing( bool t )
+{
+    Simulator::self()->waitCircuit(); // Simulation thread writes to trace buffers
+    if( t ) SimTrace::clear();         // Start a new timeline
+    SimTrace::setEnabled( t );
+}
+
+void ProfilerDialog::saveTrace()
+{
+    QString fileName = QFileDialog::getSaveFileName( this, tr("Save Trace"), "",
+                                                     tr("Trace files (*.json);;All files (*)"));
+    if( fileName.isEmpty() ) return;
+    if( !fileName.endsWith(".json") ) fileName.append(".json");
+
+    bool tracing = SimTrace::enabled();
+    SimTrace::setEnabled( false );    // Stop recording while saving
+    Simulator::self()->waitCircuit(); // Let Simulation thread close open spans
+
+    if( !SimTrace::save( fileName ) )
+        QMessageBox::warning( this, tr("Save Trace"), tr("Could not save trace to:\n")+fileName );
+
+    SimTrace::setEnabled( tracing );
+}
+
+static QTableWidgetItem* numItem( double value )
+{
+    QTableWidgetItem* item = new QTableWidgetItem();
+    item->setData( Qt::DisplayRole, value ); // Numeric sorting
+    item->setTextAlignment( Qt::AlignRight | Qt::AlignVCenter );
+    return item;
+}
+
+void ProfilerDialog::updateTable()
+{
+    SimProfiler* profiler = Simulator::self()->profileData();
+    SimProfiler::counters_t counters = profiler->counters();
+
+    m_summary->setText( tr("Simulated: %1 ms   Events: %2 scheduled, %3 cancelled   "
+                           "Non linear iterations: %4   Node stamps: %5")
+                        .arg( counters.simTime/1e9 ).arg( counters.scheduled ).arg( counters.cancelled )
+                        .arg( counters.nlIterations ).arg( counters.nodeStamps ) );
+
+    m_table->setSortingEnabled( false );
+    m_table->setRowCount( 0 );
+
+    if( m_view->currentIndex() == 2 ) // Matrix groups
+    {
+        m_table->setColumnCount( 6 );
+        m_table->setHorizontalHeaderLabels( { tr("Group"), tr("Nodes"), tr("Factorizations")
+                                            , tr("Factor ms"), tr("Solves"), tr("Solve ms") } );
+        QVector<SimProfiler::groupStat_t> groups = profiler->groups();
+        for( int i=0; i<groups.size(); ++i )
+        {
+            const SimProfiler::groupStat_t& g = groups.at(i);
+            if( !g.solves ) continue;
+            int row = m_table->rowCount();
+            m_table->insertRow( row );
+            m_table->setItem( row, 0, numItem( i ) );
+            m_table->setItem( row, 1, numItem( g.size ) );
+            m_table->setItem( row, 2, numItem( g.factors ) );
+            m_table->setItem( row, 3, numItem( g.factorNs/1e6 ) );
+            m_table->setItem( row, 4, numItem( g.solves ) );
+            m_table->setItem( row, 5, numItem( g.solveNs/1e6 ) );
+        }
+    }else{
+        bool byType = m_view->currentIndex() == 0;
+        QList<SimProfiler::elmStat_t> stats = byType ? profiler->types() : profiler->elements();
+
+        m_table->setColumnCount( 10 );
+        m_table->setHorizontalHeaderLabels( { byType ? tr("Type") : tr("Element"), byType ? tr("Count") : tr("Type")
+                                            , tr("Events"), tr("Event ms"), tr("voltChanged"), tr("voltChanged ms")
+                                            , tr("Stamps"), tr("Stamp ms"), tr("Total ms"), "%" } );
+        double totalNs = 0;
+        for( const SimProfiler::elmStat_t& s : stats ) totalNs += s.eventNs+s.voltNs+s.stampNs;
+        if( totalNs == 0 ) totalNs = 1;
+
+        m_table->setRowCount( stats.size() );
+        for( int row=0; row<stats.size(); ++row )
+        {
+            const SimProfiler::elmStat_t& s = stats.at( row );
+            double ns = s.eventNs+s.voltNs+s.stampNs;
+
+            m_table->setItem( row, 0, new QTableWidgetItem( byType ? s.type : s.id ) );
+            if( byType ) m_table->setItem( row, 1, numItem( s.count ) );
+            else         m_table->setItem( row, 1, new QTableWidgetItem( s.type ) );
+            m_table->setItem( row, 2, numItem( s.events ) );
+            m_table->setItem( row, 3, numItem( s.eventNs/1e6 ) );
+            m_table->setItem( row, 4, numItem( s.voltChanges ) );
+            m_table->setItem( row, 5, numItem( s.voltNs/1e6 ) );
+            m_table->setItem( row, 6, numItem( s.stamps ) );
+            m_table->setItem( row, 7, numItem( s.stampNs/1e6 ) );
+            m_table->setItem( row, 8, numItem( ns/1e6 ) );
+            m_table->setItem( row, 9, numItem( qRound( 1000*ns/totalNs )/10.0 ) );
+        }
+    }
+    m_table->setSortingEnabled( true );
+}
@@ -0,0 +1,49 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef PROFILERDIALOG_H
+#define PROFILERDIALOG_H
+
+#include <QDialog>
+#include <QTimer>
+
+class QTableWidget;
+class QComboBox;
+class QCheckBox;
+class QLabel;
+
+// Shows Simulator profiler data: time per element type, per element
+// and matrix node groups. Table is refreshed once per second.
+// Also controls trace timeline recording (SimTrace).
+
+class ProfilerDialog : public QDialog
+{
+    Q_OBJECT
+    public:
+        ProfilerDialog( QWidget* parent=0 );
+
+        void updateTable();
+
+    protected:
+        virtual void showEvent( QShowEvent* ) override;
+        virtual void hideEvent( QHideEvent* ) override;
+
+    private:
+        void setProfiling( bool p );
+        void reset();
+        void save();
+        void setTracing( bool t );
+        void saveTrace();
+
+        QTableWidget* m_table;
+        QComboBox*    m_view;
+        QCheckBox*    m_enable;
+        QCheckBox*    m_trace;
+        QLabel*       m_summary;
+
+        QTimer m_timer;
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include <QClipboard>
 #include <QMimeData>
 #include <QSettings>
+#include <QGraphicsView>
 
 #include "circuit.h"
 #include "simulator.h"
@@ -34,6 +35,9 @@ Circuit::Circuit( int width, int height, CircuitView* parent )
        : QGraphicsScene( parent )
 {
     m_simulator = new Simulator();
+    m_simulator->setObserver( CircuitWidget::self() );
+    if( MainWindow::self()->settings()->contains("Circuit/animBudget") )
+        m_simulator->setAnimBudget( MainWindow::self()->settings()->value("Circuit/animBudget").toInt() );
     Tunnel::clearTunnels();
 
     setObjectName( "Circuit" );
@@ -68,6 +72,8 @@ Circuit::Circuit( int width, int height, CircuitView* parent )
     m_circRev    = MainWindow::self()->revision();
     m_backupPath = MainWindow::self()->getConfigPath("backup.sim1");
     m_hideGrid   = MainWindow::self()->settings()->value("Circuit/hideGrid" ).toBool();
+    m_cacheRender = MainWindow::self()->settings()->value("Circuit/cacheRender" ).toBool();
+    m_itemsCached = false;
     m_maxUndoSteps = MainWindow::self()->settings()->value("Circuit/undoSteps" ).toInt();
     if( m_maxUndoSteps == 0 ) m_maxUndoSteps = 100;
     m_filePath   = "";//qApp->applicationDirPath()+"/new.simu"; // AppImage tries to write in read olny filesystem
@@ -519,6 +525,9 @@ void Circuit::addComponent( Component* comp )
     addItem( comp );
     if( comp->itemType() == "Package" ) m_compList.prepend( comp );
     else                                m_compList.append( comp );
+
+    if( m_itemsCached && !m_simulator->isUpdated( comp ) )
+        comp->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
 }
 
 Component* Circuit::createComponent( QString type, QString name, QPoint pos, bool map )
@@ -1217,8 +1226,10 @@ void Circuit::setSceneHeight( int h )
 
 void Circuit::setSize( int width, int height )
 {
+    QRect oldRect = m_scenerect;
     m_scenerect.setRect( -width/2, -height/2, width, height );
     setSceneRect( m_scenerect );
+    invalidate( oldRect.united( m_scenerect ), BackgroundLayer ); // Background may be cached
     update();
 }
 
@@ -1227,9 +1238,38 @@ void Circuit::setDrawGrid( bool draw )
     m_hideGrid = !draw;
     if( m_hideGrid ) MainWindow::self()->settings()->setValue( "Circuit/hideGrid", "true" );
     else             MainWindow::self()->settings()->setValue( "Circuit/hideGrid", "false" );
-    update();
+    invalidate( m_scenerect, BackgroundLayer );
+}
+
+void Circuit::setCacheRender( bool cache )
+{
+    m_cacheRender = cache;
+    if( cache ) MainWindow::self()->settings()->setValue( "Circuit/cacheRender", "true" );
+    else        MainWindow::self()->settings()->setValue( "Circuit/cacheRender", "false" );
+
+    QGraphicsView::CacheMode mode = cache ? QGraphicsView::CacheBackground : QGraphicsView::CacheNone;
+    for( QGraphicsView* view : views() )
+    {
+        view->setCacheMode( mode );
+        view->resetCachedContent();
+    }
+    cacheItems( m_simulator->isRunning() );
 }
 
+void Circuit::cacheItems( bool cache ) // Called at Simulation start/stop
+{
+    // Static components are painted once into a pixmap and then just copied,
+    // components in update list are painted again only in their own area.
+    // Not used while editing: many edits don't update the items themselves.
+    m_itemsCached = cache && m_cacheRender;
+
+    for( Component* comp : m_compList )
+    {
+        QGraphicsItem::CacheMode mode = QGraphicsItem::NoCache;
+        if( m_itemsCached && !m_simulator->isUpdated( comp ) ) mode = QGraphicsItem::DeviceCoordinateCache;
+        comp->setCacheMode( mode );
+}   }
+
 void Circuit::setAnimate( bool an )
 {
     m_animate = an;
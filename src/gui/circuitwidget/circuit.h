@@ -40,6 +40,10 @@ class Circuit : public QGraphicsScene
         bool animate() { return m_animate; }
         void setAnimate( bool an );
 
+        bool cacheRender() { return m_cacheRender; }
+        void setCacheRender( bool cache );
+        void cacheItems( bool cache );
+
         int sceneWidth() { return m_sceneWidth; }
         void setSceneWidth( int w );
 
@@ -184,6 +188,8 @@ class Circuit : public QGraphicsScene
         bool m_loading;
         bool m_conStarted;
         bool m_hideGrid;
+        bool m_cacheRender;
+        bool m_itemsCached;
 
         bool m_compRemoved;
         bool m_animate;
@@ -65,6 +65,7 @@ void CircuitView::clear()
     }
     m_circuit = new Circuit( 3200, 2400, this );
     setScene( m_circuit );
+    setCacheMode( m_circuit->cacheRender() ? CacheBackground : CacheNone );
     resetMatrix();
     m_scale = 1;
     m_enterItem = NULL;
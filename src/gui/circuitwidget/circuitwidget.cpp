@@ -7,6 +7,7 @@
 #include <QToolButton>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QDesktopServices>
 #include <QSettings>
 
@@ -16,6 +17,7 @@
 #include "simulator.h"
 #include "circuit.h"
 #include "appdialog.h"
+#include "profilerdialog.h"
 #include "filebrowser.h"
 #include "infowidget.h"
 #include "about.h"
@@ -37,6 +39,7 @@ CircuitWidget::CircuitWidget( QWidget *parent  )
 
     m_appPropW = NULL;
     m_about = NULL;
+    m_profilerW = NULL;
 
     m_verticalLayout.setObjectName( "verticalLayout" );
     m_verticalLayout.setContentsMargins(0, 0, 0, 0);
@@ -153,6 +156,21 @@ void CircuitWidget::createActions()
     connect( pauseSimAct, &QAction::triggered,
              this, &CircuitWidget::pauseCirc, Qt::UniqueConnection );
 
+    saveCheckAct = new QAction( QIcon(":/save.svg"),tr("Save Checkpoint"), this);
+    saveCheckAct->setStatusTip(tr("Save Simulation state to file"));
+    connect( saveCheckAct, &QAction::triggered,
+                     this, &CircuitWidget::saveCheckpoint, Qt::UniqueConnection );
+
+    loadCheckAct = new QAction( QIcon(":/open.svg"),tr("Load Checkpoint"), this);
+    loadCheckAct->setStatusTip(tr("Restore Simulation state from file"));
+    connect( loadCheckAct, &QAction::triggered,
+                     this, &CircuitWidget::loadCheckpoint, Qt::UniqueConnection );
+
+    profilerAct = new QAction( QIcon(":/config.svg"),tr("Profiler"), this);
+    profilerAct->setStatusTip(tr("Show time spent by each element type"));
+    connect( profilerAct, &QAction::triggered,
+                    this, &CircuitWidget::openProfiler, Qt::UniqueConnection );
+
     settAppAct = new QAction( QIcon(":/config.svg"),tr("Settings"), this);
     settAppAct->setStatusTip(tr("Settings"));
     connect( settAppAct, &QAction::triggered,
@@ -215,6 +233,17 @@ void CircuitWidget::createToolBars()
 
     m_circToolBar.addAction( powerCircAct );
     m_circToolBar.addAction( pauseSimAct );
+
+    m_checkMenu.addAction( saveCheckAct );
+    m_checkMenu.addAction( loadCheckAct );
+    m_checkMenu.addSeparator();
+    m_checkMenu.addAction( profilerAct );
+    QToolButton* checkButton = new QToolButton( this );
+    checkButton->setToolTip( tr("Checkpoints and Profiler") );
+    checkButton->setMenu( &m_checkMenu );
+    checkButton->setIcon( QIcon(":/simpaused.png") );
+    checkButton->setPopupMode( QToolButton::InstantPopup );
+    m_circToolBar.addWidget( checkButton );
     m_circToolBar.addSeparator();//..........................
 
     spacer = new QWidget();
@@ -373,6 +402,7 @@ void CircuitWidget::powerCircOn()
     setMsg( " "+tr("Running")+" ", 0 );
 
     Simulator::self()->startSim();
+    Circuit::self()->cacheItems( true );
 }
 
 void CircuitWidget::powerCircOff()
@@ -389,6 +419,7 @@ void CircuitWidget::powerCircOff()
     setMsg( " "+tr("Stopped")+" ", 1 );
 
     m_infoWidget->setRate( 0, 0 );
+    Circuit::self()->cacheItems( false );
     Circuit::self()->update();
 }
 
@@ -406,6 +437,7 @@ void CircuitWidget::powerCircDebug()
     m_infoWidget->setRate(-1 );  //m_rateLabel->setText( tr("Speed: Debugger") );
 
     Simulator::self()->startSim( true );
+    Circuit::self()->cacheItems( true );
 }
 
 void CircuitWidget::pauseDebug()
@@ -446,6 +478,50 @@ void CircuitWidget::pauseCirc()
     }
 }
 
+void CircuitWidget::saveCheckpoint()
+{
+    if( !Simulator::self()->isRunning() ) { setMsg( " "+tr("Simulation not running")+" ", 1 ); return; }
+    if( !Simulator::self()->isPaused() ) pauseCirc();
+
+    QString dir = QFileInfo( m_curCirc ).absolutePath();
+    QString fileName = QFileDialog::getSaveFileName( this, tr("Save Checkpoint"), dir,
+                                                     tr("Checkpoints (*.simck);;All files (*)"));
+    if( fileName.isEmpty() ) return;
+    if( !fileName.endsWith(".simck") ) fileName.append(".simck");
+
+    if( !Simulator::self()->saveCheckpoint( fileName ) )
+        QMessageBox::warning( this, tr("Save Checkpoint"), tr("Could not save checkpoint to:\n")+fileName );
+    else unsavedWarning( tr("Save Checkpoint") );
+}
+
+void CircuitWidget::loadCheckpoint()
+{
+    QString dir = QFileInfo( m_curCirc ).absolutePath();
+    QString fileName = QFileDialog::getOpenFileName( this, tr("Load Checkpoint"), dir,
+                                                     tr("Checkpoints (*.simck);;All files (*)"));
+    if( fileName.isEmpty() ) return;
+
+    if( !Simulator::self()->isRunning() ) powerCircOn();
+    if( !Simulator::self()->isPaused() ) pauseCirc();
+
+    if( Simulator::self()->loadCheckpoint( fileName ) )
+    {
+        setMsg( " "+tr("Checkpoint loaded")+" ", 1 );
+        unsavedWarning( tr("Load Checkpoint") );
+    }
+    else QMessageBox::warning( this, tr("Load Checkpoint"), tr("Checkpoint doesn't match this Circuit:\n")+fileName );
+}
+
+void CircuitWidget::unsavedWarning( QString title )
+{
+    QStringList unsaved = Simulator::self()->unsavedElements();
+    if( unsaved.isEmpty() ) return;
+    if( unsaved.size() > 10 ) { unsaved = unsaved.mid( 0, 10 ); unsaved.append("..."); }
+
+    QMessageBox::warning( this, title, tr("Internal state of these elements is not included in checkpoints,\n"
+                                          "simulation may diverge from the original run:\n\n")+unsaved.join("\n") );
+}
+
 void CircuitWidget::settApp()
 {
     if( !m_appPropW )
@@ -457,6 +533,12 @@ void CircuitWidget::settApp()
     m_appPropW->show();
 }
 
+void CircuitWidget::openProfiler()
+{
+    if( !m_profilerW ) m_profilerW = new ProfilerDialog( this );
+    m_profilerW->show();
+}
+
 void CircuitWidget::openInfo()
 { QDesktopServices::openUrl(QUrl("http://simulide.com")); }
 
@@ -466,6 +548,31 @@ void CircuitWidget::about()
     m_about->show();
 }
 
+void CircuitWidget::simError( QString error )
+{
+    powerCircOff();
+    setError( error );
+}
+
+void CircuitWidget::simFrame()
+{
+    EditorWindow::self()->outPane()->updateStep(); // OutPanel in Editor can be created before this simulator.
+}
+
+void CircuitWidget::simRate( double speed, double simLoad, double guiLoad, int fps )
+{ m_infoWidget->setRate( speed, simLoad, guiLoad, fps ); }
+
+void CircuitWidget::simTime( uint64_t time ) { m_infoWidget->setCircTime( time ); }
+
+void CircuitWidget::simTargetSpeed( double speed ) { m_infoWidget->setTargetSpeed( speed ); }
+
+bool CircuitWidget::simAnimate() { return Circuit::self()->animate(); }
+
+QRectF CircuitWidget::simViewArea()
+{
+    return m_circView.mapToScene( m_circView.viewport()->rect() ).boundingRect();
+}
+
 void CircuitWidget::setError( QString error )
 {
     setMsg( error, 2 );
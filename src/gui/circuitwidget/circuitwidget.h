@@ -12,14 +12,16 @@
 
 #include "circuitview.h"
 #include "outpaneltext.h"
+#include "simobserver.h"
 
 class QSplitter;
 class QLabel;
 class AboutDialog;
 class AppDialog;
+class ProfilerDialog;
 class InfoWidget;
 
-class CircuitWidget : public QWidget
+class CircuitWidget : public QWidget, public SimObserver
 {
     Q_OBJECT
 
@@ -40,7 +42,17 @@ class CircuitWidget : public QWidget
         void pauseDebug();
         void resumeDebug();
 
-        void simDebugMessage( QString msg ) { m_outPane.appendLine( msg.remove("\"") ); }
+        // SimObserver:
+        virtual void simDebugMessage( QString msg ) override { m_outPane.appendLine( msg.remove("\"") ); }
+        virtual void simPowerOff() override { powerCircOff(); }
+        virtual void simMessage( QString msg, int type ) override { setMsg( msg, type ); }
+        virtual void simError( QString error ) override;
+        virtual void simFrame() override;
+        virtual void simRate( double speed, double simLoad, double guiLoad, int fps ) override;
+        virtual void simTime( uint64_t time ) override;
+        virtual void simTargetSpeed( double speed ) override;
+        virtual bool simAnimate() override;
+        virtual QRectF simViewArea() override;
 
         QSplitter* splitter() { return m_mainSplitter; }
         QSplitter* panelSplitter() { return m_panelSplitter; }
@@ -55,6 +67,9 @@ class CircuitWidget : public QWidget
         void saveCircAs();
         void powerCirc();
         void pauseCirc();
+        void saveCheckpoint();
+        void loadCheckpoint();
+        void openProfiler();
         void settApp();
         void openInfo();
         void about();
@@ -65,6 +80,7 @@ class CircuitWidget : public QWidget
     private:
         void createActions();
         void createToolBars();
+        void unsavedWarning( QString title );
 
  static CircuitWidget* m_pSelf;
 
@@ -94,6 +110,9 @@ class CircuitWidget : public QWidget
         QAction* zoomOneAct;
         QAction* powerCircAct;
         QAction* pauseSimAct;
+        QAction* saveCheckAct;
+        QAction* loadCheckAct;
+        QAction* profilerAct;
         QAction* settAppAct;
         QAction* infoAct;
         QAction* aboutAct;
@@ -101,12 +120,14 @@ class CircuitWidget : public QWidget
         
         QMenu m_fileMenu;
         QMenu m_infoMenu;
+        QMenu m_checkMenu;
         
         QString m_curCirc;
         QString m_lastCircDir;
 
         AppDialog*   m_appPropW;
         AboutDialog* m_about;
+        ProfilerDialog* m_profilerW;
 };
 
 #endif
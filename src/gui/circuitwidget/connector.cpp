@@ -379,9 +379,12 @@ void Connector::splitCon( int index, Pin* pin0, Pin* pin2 )
     Circuit::self()->removeConnector( this );
 }
 
-void Connector::updateLines()
+void Connector::updateLines( const QRectF& area ) // Only lines in area (if not null)
 {
-    for( ConnectorLine* line : m_conLineList ) line->update();
+    for( ConnectorLine* line : m_conLineList )
+    {
+        if( area.isNull() || area.intersects( line->sceneBoundingRect() ) ) line->update();
+    }
 
     /*eNode* enode = startPin()->getEnode();
     if( enode && enode->voltchanged() )
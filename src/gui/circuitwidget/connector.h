@@ -6,6 +6,8 @@
 #ifndef CONNECTOR_H
 #define CONNECTOR_H
 
+#include <QRectF>
+
 #include "compbase.h"
 
 class ConnectorLine;
@@ -45,7 +47,7 @@ class Connector : public CompBase
         void closeCon( Pin* endpin );
         void splitCon( int index, Pin* pin0, Pin* pin2 );
 
-        void updateLines();
+        void updateLines( const QRectF& area=QRectF() );
 
         void setVisib(  bool vis );
         void setSelected( bool selected );
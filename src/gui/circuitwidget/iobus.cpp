@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include "iobus.h"
+#include "iopin.h"
+#include "simulator.h"
+
+IoBus::IoBus( QString id )
+     : eElement( id )
+{
+    m_startTime = 0;
+    m_stepTime  = 0;
+}
+IoBus::~IoBus()
+{
+    while( m_active.size() ) remPin( m_active.back() );
+}
+
+void IoBus::initialize()
+{
+    for( IoPin* pin : m_active ) pin->m_bus = nullptr;
+    m_active.clear();
+}
+
+void IoBus::runEvent()
+{
+    for( uint i=0; i<m_active.size(); )
+    {
+        IoPin* pin = m_active[i];
+        if( pin->nextStep() ) i++; // Else pin finished edge and was removed
+    }
+    if( m_active.size() ) Simulator::self()->addEvent( m_stepTime, this );
+}
+
+void IoBus::scheduleState( IoPin* pin, bool state )
+{
+    if( pin->m_nextState == state ) return;
+
+    uint64_t circTime = Simulator::self()->circTime();
+    bool idle = m_active.empty();
+
+    if( pin->m_bus || pin->m_step || !pin->m_steps                      // Edge already running or no slope
+     || (!idle && m_startTime != circTime) )                            // Group edge started before
+    { pin->scheduleState( state, 0 ); return; }
+
+    bool nextState = pin->m_inverted ? !state : state;
+    uint64_t stepTime = pin->stepTime( nextState );
+
+    if( !idle && stepTime != m_stepTime ) { pin->scheduleState( state, 0 ); return; } // Different edge
+
+    pin->m_nextState = state;
+    pin->m_bus = this;
+    m_active.push_back( pin );
+    pin->nextStep();            // First step now
+
+    if( idle )
+    {
+        m_startTime = circTime;
+        m_stepTime  = stepTime;
+        Simulator::self()->addEvent( stepTime, this );
+}   }
+
+void IoBus::remPin( IoPin* pin )
+{
+    pin->m_bus = nullptr;
+    for( uint i=0; i<m_active.size(); ++i )
+    {
+        if( m_active[i] != pin ) continue;
+        m_active[i] = m_active.back();
+        m_active.pop_back();
+        break;
+    }
+    if( m_active.empty() ) Simulator::self()->cancelEvents( this );
+}
@@ -0,0 +1,35 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef IOBUS_H
+#define IOBUS_H
+
+#include "e-element.h"
+
+class IoPin;
+
+// Drives output edges of a group of IoPins (ports, buses).
+// Pins changing at the same time with same edge timing share
+// one slope: one event per step for the whole group.
+
+class IoBus : public eElement
+{
+    public:
+        IoBus( QString id );
+        ~IoBus();
+
+        virtual void initialize() override;
+        virtual void runEvent() override;
+
+        void scheduleState( IoPin* pin, bool state );
+        void remPin( IoPin* pin );
+
+    private:
+        std::vector<IoPin*> m_active; // Pins in current edge
+
+        uint64_t m_startTime;
+        uint64_t m_stepTime;
+};
+#endif
@@ -5,12 +5,16 @@
 
 #include <QtMath>
 #include <QMenu>
+#include <QDataStream>
 
 #include "iopin.h"
+#include "iobus.h"
 #include "simulator.h"
 #include "circuit.h"
 
 eNode IoPin::m_gndEnode("");
+std::vector<double> IoPin::m_slopeFrac;
+std::vector<double> IoPin::m_slopeDelta;
 
 IoPin::IoPin( int angle, const QPoint pos, QString id, int index, Component* parent, pinMode_t mode )
      : Pin( angle, pos, id, index, parent )
@@ -19,6 +23,7 @@ IoPin::IoPin( int angle, const QPoint pos, QString id, int index, Component* par
     m_outState = false;
     m_stateZ   = false;
     m_skipStamp = false;
+    m_analogIn  = false;
 
     m_inpHighV = 2.5;
     m_inpLowV  = 2.5;
@@ -40,16 +45,22 @@ IoPin::IoPin( int angle, const QPoint pos, QString id, int index, Component* par
     m_timeRis = 3750; // picoseconds
     m_timeFal = 3750;
 
+    m_bus = nullptr;
+
     m_pinMode = undef_mode;
     setPinMode( mode );
     animate( Circuit::self()->animate() );
 }
-IoPin::~IoPin(){}
+IoPin::~IoPin()
+{
+    if( m_bus ) m_bus->remPin( this );
+}
 
 void IoPin::initialize()
 {
     m_step = 0;
     m_steps = Simulator::self()->slopeSteps();
+    if( m_slopeFrac.size() != (uint)m_steps+1 ) createSlopeTables( m_steps );
 
     m_inpState  = false;
     m_outState  = false;
@@ -58,6 +69,8 @@ void IoPin::initialize()
 
 void IoPin::stamp()
 {
+    if( m_steps && Simulator::self()->collapseSlopes() && !analogNet() ) m_steps = 0;
+
     if( m_skipStamp ) return;
 
     ePin::setEnodeComp( &m_gndEnode );
@@ -91,37 +104,88 @@ void IoPin::updateStep()
 }
 
 void IoPin::runEvent()
+{
+    if( !nextStep() ) return;
+
+    bool nextState = m_inverted ? !m_nextState : m_nextState;
+    Simulator::self()->addEvent( stepTime( nextState ), this );
+}
+
+bool IoPin::nextStep() // Returns false when edge is finished
 {
     if( m_step == m_steps )
     {
         m_step = 0;
         IoPin::setOutState( m_nextState );
+        return false;
     }else{
         bool nextState = m_inverted ? !m_nextState : m_nextState;
 
         if( m_pinMode == openCo )
         {
-            double step = nextState ? m_step : m_steps-m_step;
-            double delta =  qPow( 1e4*step/m_steps, 2 );
-            m_gndAdmit = 1/(m_outputImp+delta);
+            int step = nextState ? m_step : m_steps-m_step;
+            m_gndAdmit = 1/(m_outputImp+m_slopeDelta[step]);
             updtState();
         }else{
-            double delta = m_step;
-            if( m_step == 0 ) delta = 1e-5;
-            if( nextState ) stampVolt( m_outLowV+delta*(m_outHighV-m_outLowV)/m_steps ); // L to H
-            else            stampVolt( m_outHighV-delta*(m_outHighV-m_outLowV)/m_steps );// H to L
+            double delta = m_slopeFrac[m_step]*(m_outHighV-m_outLowV);
+            if( nextState ) stampVolt( m_outLowV+delta ); // L to H
+            else            stampVolt( m_outHighV-delta );// H to L
         }
-        int time = nextState ? m_timeRis : m_timeFal;
-        Simulator::self()->addEvent( time/m_steps, this );
         m_step++;
+        return true;
+}   }
+
+void IoPin::saveState( QDataStream& out )
+{
+    out << (quint8)m_pinMode << m_stateZ << m_inpState << m_outState << m_nextState << (m_step > 0) << m_outVolt;
+}
+
+void IoPin::loadState( QDataStream& in ) // Edges in progress are restored at final state
+{
+    quint8 mode;
+    bool stateZ, outState, nextState, inEdge;
+    double outVolt;
+    in >> mode >> stateZ >> m_inpState >> outState >> nextState >> inEdge >> outVolt;
+
+    m_step = 0;
+    setPinMode( (pinMode_t)mode );
+    if( m_stateZ != stateZ ) setStateZ( stateZ );
+    IoPin::setOutState( inEdge ? nextState : outState );
+    m_nextState = nextState;                  // Can differ if a delayed change is scheduled
+
+    if( inEdge ) Simulator::self()->cancelEvents( this );
+    else if( m_pinMode >= output && !m_stateZ ) setVoltage( outVolt ); // Analog outputs (Wave Gen, Dac...)
+}
+
+void IoPin::createSlopeTables( int steps ) // Shared by all pins: same steps for all
+{
+    m_slopeFrac.resize( steps+1 );
+    m_slopeDelta.resize( steps+1 );
+    if( steps ) for( int i=0; i<=steps; ++i )
+    {
+        m_slopeFrac[i]  = (i ? i : 1e-5)/steps;
+        m_slopeDelta[i] = qPow( 1e4*i/steps, 2 );
     }
 }
 
+bool IoPin::analogNet() // Something other than logic pins connected to this net
+{
+    if( !m_enode ) return false;
+    for( ePin* epin : m_enode->getEpins() )
+    {
+        IoPin* ioPin = dynamic_cast<IoPin*>( epin );
+        if( !ioPin || ioPin->isAnalogIn() ) return true;
+    }
+    return false;
+}
+
 void IoPin::scheduleState( bool state, uint64_t time )
 {
     if( m_nextState == state ) return;
     m_nextState = state;
 
+    if( m_bus ) m_bus->remPin( this ); // Leave bus edge, continue alone
+
     if( m_step )
     {
         Simulator::self()->cancelEvents( this );
@@ -192,6 +256,7 @@ bool IoPin::getInpState()
 
 void IoPin::setOutState( bool high ) // Set Output to Hight or Low
 {
+    if( m_bus ) m_bus->remPin( this );
     m_outState = m_nextState = high;
     if( m_pinMode < openCo || m_stateZ ) return;
 
@@ -21,11 +21,13 @@ enum pinMode_t{
 };
 
 class eNode;
+class IoBus;
 class asIScriptEngine;
 
 class IoPin : public Pin, public eElement
 {
         friend class Function;
+        friend class IoBus;
     public:
         IoPin( int angle, const QPoint pos, QString id, int index, Component* parent, pinMode_t mode=source );
         ~IoPin();
@@ -35,6 +37,9 @@ class IoPin : public Pin, public eElement
         virtual void updateStep() override;
         virtual void runEvent() override;
 
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
+
         virtual void scheduleState( bool state, uint64_t time );
 
         //pinMode_t pinMode() { return m_pinMode; }
@@ -83,6 +88,10 @@ class IoPin : public Pin, public eElement
 
         void skipStamp( bool s ) { m_skipStamp = s; }
 
+        // Pin reading analog voltages (ADC, comparator, scope...): keeps slopes in its net
+        bool isAnalogIn() { return m_analogIn || m_pinMode == undef_mode; }
+        void setAnalogIn( bool a ) { m_analogIn = a; }
+
         void setRiseTime( double time ) { m_timeRis = time; }
         void setFallTime( double time ) { m_timeFal = time; }
 
@@ -109,6 +118,12 @@ class IoPin : public Pin, public eElement
         inline void stampAll();
         inline void stampVolt( double v) { ePin::stampCurrent( v*m_admit ); }
 
+        bool nextStep();
+        uint64_t stepTime( bool nextState ) { return (nextState ? m_timeRis : m_timeFal)/m_steps; }
+
+        bool analogNet();
+ static void createSlopeTables( int steps );
+
         double m_inpHighV;  // currently in eClockedDevice
         double m_inpLowV;
 
@@ -131,6 +146,7 @@ class IoPin : public Pin, public eElement
         bool m_stateZ;
         bool m_nextState;
         bool m_skipStamp;
+        bool m_analogIn;
 
         int m_steps;
         uint64_t m_timeRis;  // Time for Output voltage to switch from 0% to 100%
@@ -138,6 +154,11 @@ class IoPin : public Pin, public eElement
 
         pinMode_t m_pinMode;
 
+        IoBus* m_bus;        // Bus driving current edge
+
         static eNode m_gndEnode;
+
+        static std::vector<double> m_slopeFrac;  // Slope fraction at each step
+        static std::vector<double> m_slopeDelta; // Open Collector extra impedance at each step
 };
 #endif
@@ -13,6 +13,9 @@
 #include <QDrag>
 #include <QMenu>
 #include <QDir>
+#include <QSet>
+#include <QFileInfo>
+#include <QDateTime>
 
 #include "componentlist.h"
 #include "treeitem.h"
@@ -22,6 +25,9 @@
 #include "chip.h"
 #include "utils.h"
 
+#define CACHE_MAGIC   0x534C4958
+#define CACHE_VERSION 1
+
 ComponentList* ComponentList::m_pSelf = NULL;
 
 ComponentList::ComponentList( QWidget* parent )
@@ -59,6 +65,8 @@ void ComponentList::createList()
     m_oldConfig = !QFile::exists( m_listFile ); // xml file doesn't exist: read old config
     m_restoreList = !m_oldConfig; // Restore last List
 
+    readCache();
+
     m_customComp = false;
     LoadLibraryItems();
     m_customComp = true;
@@ -79,43 +87,7 @@ void ComponentList::createList()
         LoadCompSetAt( userDir );
 
         QDir compSetDir( userDir );
-        if( compSetDir.cd("test") )  // Load Test Components
-        {
-            QStringList dirList = compSetDir.entryList( {"*"}, QDir::Dirs );
-            if( !dirList.isEmpty() )
-            {
-                qDebug() << "\n" << tr("    Loading Component sets at:")<< "\n" << compSetDir.absolutePath()<<"\n";
-
-                TreeItem* catItem = getCategory("test");
-                if( !catItem ) catItem = addCategory("test","test","","" );
-
-                for( QString compName : dirList )
-                {
-                    QString path = compName+"/"+compName;
-                    QString icon = getIcon( "test", compName );
-                    QString compFile;
-                    QString type;
-
-                    if( compSetDir.exists( path+".sim1") )
-                    {
-                        if( icon.isEmpty() ) icon = ":/subc.png";
-                        type = "Subcircuit";
-                        compFile = compSetDir.absoluteFilePath( path+".sim1" );
-                    }
-                    else if( compSetDir.exists( path+".mcu") )
-                    {
-                        if( icon.isEmpty() ) icon = ":/ic2.png";
-                        type = "MCU";
-                    }
-                    if( !type.isEmpty() && !m_components.contains( compName ) )
-                    {
-                        addItem( compName, catItem, icon, type );
-                        m_dirFileList[ compName ] = compSetDir.absoluteFilePath( compName );
-                        if( !compFile.isEmpty() ) m_dataFileList[ compName ] = compFile;   // Save sim1 File used to create this item
-                    }
-                }
-            }
-        }
+        if( compSetDir.cd("test") ) loadTestSet( compSetDir ); // Load Test Components
     }
 
     QDir compSetDir = MainWindow::self()->getFilePath("data");
@@ -129,6 +101,12 @@ void ComponentList::createList()
         QTreeWidgetItem* pa = it->parent();
         if( pa ) pa->removeChild( it  );
     }
+    if( m_cacheChanged || m_libIndex.size() != m_libCache.size() ) writeCache();
+
+    m_libCache.clear();
+    m_libIndex.clear();
+    m_dataPaths.clear();
+    m_searchItems.clear(); // Search index will be created at first search
 }
 
 void ComponentList::LoadLibraryItems()
@@ -138,8 +116,8 @@ void ComponentList::LoadLibraryItems()
         QString category = item->category();
 
         QString icon = item->iconfile();
-        QString iconFile = MainWindow::self()->getDataFilePath("images/"+icon );
-        if( !QFile::exists( iconFile ) ) iconFile = ":/"+icon; // Image not in simulide data folder, use hardcoded image
+        QString iconFile = dataFilePath("images/"+icon );
+        if( iconFile.isEmpty() ) iconFile = ":/"+icon; // Image not in simulide data folder, use hardcoded image
 
         if( item->createItemFnPtr() )
         {
@@ -172,86 +150,302 @@ void ComponentList::LoadCompSetAt( QDir compSetDir )
 }
 
 void ComponentList::loadXml( QString xmlFile )
+{
+    libFile_t lib;
+    if( !getCached( xmlFile, &lib ) )
+    {
+        if( parseXml( xmlFile, &lib ) ) setCached( xmlFile, &lib ); // Don't cache files with errors
+        else if( lib.sets.isEmpty() ) return;
+    }
+    addLibFile( &lib );
+
+    QString compSetName = xmlFile.split( "/").last();
+
+    qDebug() << tr("        Loaded Component set:           ") << compSetName;
+}
+
+bool ComponentList::parseXml( QString xmlFile, libFile_t* lib )
 {
     QFile file( xmlFile );
     if( !file.open(QFile::ReadOnly | QFile::Text) ){
           qDebug() << "ComponentList::loadXml Cannot read file"<< endl << xmlFile << endl << file.errorString();
-          return;
+          return false;
     }
+    QString xmlPath = QFileInfo( xmlFile ).absolutePath();
+
     QXmlStreamReader reader( &file );
     if( reader.readNextStartElement() )
     {
         if( reader.name() != "itemlib" ){
             qDebug() <<  "ComponentList::loadXml Error parsing file (itemlib):"<< endl << xmlFile;
             file.close();
-            return;
+            return false;
         }
         while( reader.readNextStartElement() )
         {
             if( reader.name() != "itemset" ) { reader.skipCurrentElement(); continue;}
 
-            QString icon = "";
+            libSet_t set;
             if( reader.attributes().hasAttribute("icon") )
             {
-                icon = reader.attributes().value("icon").toString();
-                if( !icon.startsWith(":/") )
-                    icon = MainWindow::self()->getDataFilePath("images/"+icon);
-            }
-
-            QString catFull = reader.attributes().value("category").toString();
-            catFull.replace( "IC 74", "Logic/IC 74");
-            QStringList catPath = catFull.split("/");
-
-            TreeItem* catItem = NULL;
-            QString parent   = "";
-            QString category = "";
-            while( !catPath.isEmpty() )
-            {
-                parent = category;
-                category = catPath.takeFirst();
-                catItem = getCategory( category );
-                if( !catItem /*&& !parent.isEmpty()*/ )
-                {
-                    QString catTr = QObject::tr( category.toLocal8Bit() );
-                    catItem = addCategory( catTr, category, parent, icon );
-                }
+                set.icon = reader.attributes().value("icon").toString();
+                if( !set.icon.startsWith(":/") )
+                    set.icon = dataFilePath("images/"+set.icon );
             }
+            set.category = reader.attributes().value("category").toString();
+            set.category.replace( "IC 74", "Logic/IC 74");
 
             QString type = reader.attributes().value("type").toString();
             QString folder = reader.attributes().value("folder").toString();
 
+            QString folderPath = xmlPath+"/"+folder; // Icons are searched here
+            if( !lib->folders.contains( folderPath ) ) lib->folders.append( folderPath );
+
             while( reader.readNextStartElement() )
             {
                 if( reader.name() == "item")
                 {
-                    QString name = reader.attributes().value("name").toString();
+                    libItem_t item;
+                    item.name = reader.attributes().value("name").toString();
+                    item.type = type;
 
                     if( reader.attributes().hasAttribute("icon") )
                     {
-                        icon = reader.attributes().value("icon").toString();
-                        if( !icon.startsWith(":/") )
-                            icon = MainWindow::self()->getDataFilePath("images/"+icon);
+                        item.icon = reader.attributes().value("icon").toString();
+                        if( !item.icon.startsWith(":/") )
+                            item.icon = dataFilePath("images/"+item.icon );
                     }
-                    else icon = getIcon( folder, name );
+                    else item.icon = getIcon( folder, item.name );
 
-                    if( catItem && !m_components.contains( name ) )
-                    {
-                        if( type == "Subcircuit" )
-                        {
-                            QString compFolder = QFileInfo( xmlFile ).absolutePath()+"/"+folder+"/"+name;
-                            m_dirFileList[ name ] = compFolder;
-                        }
-                        m_dataFileList[ name ] = xmlFile;   // Save xml File used to create this item
-                        if( reader.attributes().hasAttribute("info") )
-                            name += "???"+reader.attributes().value("info").toString();
-
-                        addItem( name, catItem, icon, type );
-                    }
+                    if( type == "Subcircuit" ) item.dirFile = folderPath+"/"+item.name;
+                    item.dataFile = xmlFile;   // Save xml File used to create this item
+
+                    if( reader.attributes().hasAttribute("info") )
+                        item.info = reader.attributes().value("info").toString();
+
+                    set.items.append( item );
                     reader.skipCurrentElement();
-    }   }   }   }
-    QString compSetName = xmlFile.split( "/").last();
+            }   }
+            lib->sets.append( set );
+    }   }
+    return !reader.hasError();
+}
 
-    qDebug() << tr("        Loaded Component set:           ") << compSetName;
+void ComponentList::loadTestSet( QDir compSetDir )
+{
+    QString key = compSetDir.absolutePath();
+    libFile_t lib;
+    if( !getCached( key, &lib ) )
+    {
+        libSet_t set;
+        set.category = "test";
+
+        QStringList dirList = compSetDir.entryList( QDir::Dirs | QDir::NoDotAndDotDot );
+        for( QString compName : dirList )
+        {
+            lib.folders.append( compSetDir.absoluteFilePath( compName ) ); // Detect files added to component folder
+
+            libItem_t item;
+            item.name = compName;
+            item.icon = getIcon( "test", compName );
+
+            QString path = compName+"/"+compName;
+            if( compSetDir.exists( path+".sim1") )
+            {
+                if( item.icon.isEmpty() ) item.icon = ":/subc.png";
+                item.type = "Subcircuit";
+                item.dataFile = compSetDir.absoluteFilePath( path+".sim1" ); // Save sim1 File used to create this item
+            }
+            else if( compSetDir.exists( path+".mcu") )
+            {
+                if( item.icon.isEmpty() ) item.icon = ":/ic2.png";
+                item.type = "MCU";
+            }
+            else continue;
+
+            item.dirFile = compSetDir.absoluteFilePath( compName );
+            set.items.append( item );
+        }
+        lib.sets.append( set );
+        setCached( key, &lib );
+    }
+    if( lib.sets.first().items.isEmpty() ) return;
+
+    qDebug() << "\n" << tr("    Loading Component sets at:")<< "\n" << key<<"\n";
+    addLibFile( &lib );
+}
+
+void ComponentList::addLibFile( libFile_t* lib )
+{
+    for( libSet_t& set : lib->sets )
+    {
+        QStringList catPath = set.category.split("/");
+
+        TreeItem* catItem = NULL;
+        QString parent   = "";
+        QString category = "";
+        while( !catPath.isEmpty() )
+        {
+            parent = category;
+            category = catPath.takeFirst();
+            catItem = getCategory( category );
+            if( !catItem )
+            {
+                QString catTr = QObject::tr( category.toLocal8Bit() );
+                catItem = addCategory( catTr, category, parent, set.icon );
+            }
+        }
+        if( !catItem ) continue;
+
+        for( libItem_t& item : set.items )
+        {
+            if( m_components.contains( item.name ) ) continue;
+
+            if( !item.dirFile.isEmpty() )  m_dirFileList[ item.name ]  = item.dirFile;
+            if( !item.dataFile.isEmpty() ) m_dataFileList[ item.name ] = item.dataFile;
+
+            QString caption = item.name;
+            if( !item.info.isEmpty() ) caption += "???"+item.info;
+
+            addItem( caption, catItem, item.icon, item.type );
+}   }   }
+
+// Library index cache: parsed component sets are stored in config folder
+// and reused while files and folders keep the same modification time.
+
+void ComponentList::readCache()
+{
+    m_libCache.clear();
+    m_libIndex.clear();
+    m_dataPaths.clear();
+    m_cacheChanged = false;
+    m_cacheFile = MainWindow::self()->getConfigPath("compList.cache");
+
+    QStringList imageDirs = { MainWindow::self()->getUserFilePath("images")
+                            , MainWindow::self()->getFilePath("data/images") };
+    m_cacheStamp = QApplication::applicationVersion()+";"+MainWindow::self()->userPath()
+                 +";"+libStamp( "", imageDirs );
+
+    QFile file( m_cacheFile );
+    if( !file.open( QFile::ReadOnly ) ) return; // No cache yet
+    QByteArray data = file.readAll();           // Whole index in one read
+    file.close();
+
+    QDataStream in( data );
+    in.setVersion( QDataStream::Qt_5_0 );
+
+    quint32 magic, version;
+    QString stamp;
+    in >> magic >> version >> stamp;
+    if( magic != CACHE_MAGIC || version != CACHE_VERSION ) return;
+    if( stamp != m_cacheStamp ) return; // Image folders changed: rebuild all
+
+    QHash<QString, QString>   dataPaths;
+    QHash<QString, libFile_t> libCache;
+    in >> dataPaths >> libCache;
+
+    if( in.status() != QDataStream::Ok )
+    {
+        qDebug() << "ComponentList::readCache Error reading file:"<< endl << m_cacheFile;
+        return;
+    }
+    m_dataPaths = dataPaths;
+    m_libCache  = libCache;
+}
+
+void ComponentList::writeCache()
+{
+    QByteArray data;
+    QDataStream out( &data, QIODevice::WriteOnly );
+    out.setVersion( QDataStream::Qt_5_0 );
+
+    out << (quint32)CACHE_MAGIC << (quint32)CACHE_VERSION << m_cacheStamp;
+    out << m_dataPaths << m_libIndex;
+
+    QFile file( m_cacheFile );
+    if( !file.open( QFile::WriteOnly | QFile::Truncate ) )
+    {
+        qDebug() << "ComponentList::writeCache Cannot write file:"<< endl << m_cacheFile;
+        return;
+    }
+    file.write( data );
+    file.close();
+}
+
+bool ComponentList::getCached( QString key, libFile_t* lib )
+{
+    if( !m_libCache.contains( key ) ) return false;
+
+    libFile_t cached = m_libCache.value( key );
+    if( cached.stamp != libStamp( key, cached.folders ) ) return false; // Modified
+
+    *lib = cached;
+    m_libIndex.insert( key, cached );
+    return true;
+}
+
+void ComponentList::setCached( QString key, libFile_t* lib )
+{
+    lib->stamp = libStamp( key, lib->folders );
+    m_libIndex.insert( key, *lib );
+    m_cacheChanged = true;
+}
+
+QString ComponentList::libStamp( QString file, QStringList folders )
+{
+    QString stamp;
+    QFileInfo info( file );
+    if( !file.isEmpty() && info.exists() )
+        stamp = QString::number( info.lastModified().toMSecsSinceEpoch() )+":"+QString::number( info.size() );
+
+    for( QString folder : folders )
+    {
+        info.setFile( folder );
+        if( info.exists() ) stamp += ";"+QString::number( info.lastModified().toMSecsSinceEpoch() );
+        else                stamp += ";-";
+    }
+    return stamp;
+}
+
+QString ComponentList::dataFilePath( QString file )
+{
+    if( m_dataPaths.contains( file ) ) return m_dataPaths.value( file );
+
+    QString path = MainWindow::self()->getDataFilePath( file );
+    m_dataPaths.insert( file, path );
+    m_cacheChanged = true;
+    return path;
+}
+
+QDataStream& operator<<( QDataStream& out, const ComponentList::libItem_t& item )
+{
+    out << item.name << item.info << item.icon << item.type << item.dirFile << item.dataFile;
+    return out;
+}
+QDataStream& operator>>( QDataStream& in, ComponentList::libItem_t& item )
+{
+    in >> item.name >> item.info >> item.icon >> item.type >> item.dirFile >> item.dataFile;
+    return in;
+}
+QDataStream& operator<<( QDataStream& out, const ComponentList::libSet_t& set )
+{
+    out << set.category << set.icon << set.items;
+    return out;
+}
+QDataStream& operator>>( QDataStream& in, ComponentList::libSet_t& set )
+{
+    in >> set.category >> set.icon >> set.items;
+    return in;
+}
+QDataStream& operator<<( QDataStream& out, const ComponentList::libFile_t& lib )
+{
+    out << lib.folders << lib.stamp << lib.sets;
+    return out;
+}
+QDataStream& operator>>( QDataStream& in, ComponentList::libFile_t& lib )
+{
+    in >> lib.folders >> lib.stamp >> lib.sets;
+    return in;
 }
 
 QString ComponentList::getIcon( QString folder, QString name )
@@ -409,12 +603,47 @@ void ComponentList::slotManageComponents()
     m_mcDialog.setVisible( true );
 }
 
+void ComponentList::createSearchIndex()
+{
+    m_searchItems = findItems( "", Qt::MatchContains|Qt::MatchRecursive, 0 );
+    m_searchTexts.clear();
+    m_trigrams.clear();
+
+    for( int i=0; i<m_searchItems.size(); ++i )
+    {
+        QString text = m_searchItems.at(i)->text( 0 ).toLower();
+        m_searchTexts.append( text );
+
+        for( int j=0; j+3<=text.size(); ++j ) // Index all trigrams in item text
+        {
+            QVector<int>& items = m_trigrams[ text.mid( j, 3 ) ];
+            if( items.isEmpty() || items.last() != i ) items.append( i );
+}   }   }
+
 void ComponentList::search( QString filter )
 {
-    QList<QTreeWidgetItem*>    cList = findItems( filter, Qt::MatchContains|Qt::MatchRecursive, 0 );
-    QList<QTreeWidgetItem*> allItems = findItems( "", Qt::MatchContains|Qt::MatchRecursive, 0 );
+    if( m_searchItems.isEmpty() ) createSearchIndex();
+
+    QString text = filter.toLower();
+    QSet<QTreeWidgetItem*> cList;
+
+    if( text.size() < 3 )  // Too short for trigrams: check all items
+    {
+        for( int i=0; i<m_searchItems.size(); ++i )
+            if( m_searchTexts.at(i).contains( text ) ) cList.insert( m_searchItems.at(i) );
+    }else{
+        QVector<int> candidates; // Items containing the less frequent trigram
+        for( int j=0; j+3<=text.size(); ++j )
+        {
+            QVector<int> items = m_trigrams.value( text.mid( j, 3 ) );
+            if( j == 0 || items.size() < candidates.size() ) candidates = items;
+            if( candidates.isEmpty() ) break; // Trigram not found: no matches
+        }
+        for( int i : candidates )
+            if( m_searchTexts.at(i).contains( text ) ) cList.insert( m_searchItems.at(i) );
+    }
 
-    for( QTreeWidgetItem* item : allItems )
+    for( QTreeWidgetItem* item : m_searchItems )
     {
         TreeItem* treeItem = (TreeItem*)item;
         treeItem->setHidden( true );
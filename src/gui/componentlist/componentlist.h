@@ -8,6 +8,8 @@
 
 #include <QDropEvent>
 #include <QDir>
+#include <QHash>
+#include <QDataStream>
 #include <QTreeWidget>
 
 #include "managecomps.h"
@@ -54,6 +56,44 @@ class ComponentList : public QTreeWidget
     private:
  static ComponentList* m_pSelf;
 
+        struct libItem_t{       // Component set item as parsed from xml
+            QString name;
+            QString info;
+            QString icon;       // Resolved icon path
+            QString type;
+            QString dirFile;
+            QString dataFile;
+        };
+        struct libSet_t{
+            QString category;   // Full category path
+            QString icon;
+            QList<libItem_t> items;
+        };
+        struct libFile_t{       // Library index entry
+            QStringList folders; // Folders used to resolve file paths
+            QString stamp;       // Modification times of file and folders
+            QList<libSet_t> sets;
+        };
+ friend QDataStream& operator<<( QDataStream& out, const libItem_t& item );
+ friend QDataStream& operator>>( QDataStream& in, libItem_t& item );
+ friend QDataStream& operator<<( QDataStream& out, const libSet_t& set );
+ friend QDataStream& operator>>( QDataStream& in, libSet_t& set );
+ friend QDataStream& operator<<( QDataStream& out, const libFile_t& lib );
+ friend QDataStream& operator>>( QDataStream& in, libFile_t& lib );
+
+        bool parseXml( QString xmlFile, libFile_t* lib );
+        void loadTestSet( QDir compSetDir );
+        void addLibFile( libFile_t* lib );
+
+        void readCache();
+        void writeCache();
+        bool getCached( QString key, libFile_t* lib );
+        void setCached( QString key, libFile_t* lib );
+        QString libStamp( QString file, QStringList folders );
+        QString dataFilePath( QString file );
+
+        void createSearchIndex();
+
         void addItem( QString caption, TreeItem* catItem, QString icon, QString type );
         void addItem( QString caption, TreeItem* catItem, QIcon &icon, QString type );
 
@@ -85,6 +125,17 @@ class ComponentList : public QTreeWidget
 
         QDir m_compSetDir;
 
+        QHash<QString, libFile_t> m_libCache;  // Library index read from file
+        QHash<QString, libFile_t> m_libIndex;  // Library index used in this session
+        QHash<QString, QString>   m_dataPaths; // Resolved data file paths
+        QString m_cacheFile;
+        QString m_cacheStamp;
+        bool    m_cacheChanged;
+
+        QList<QTreeWidgetItem*> m_searchItems; // Search index
+        QStringList             m_searchTexts; // Lower case item texts
+        QHash<QString, QVector<int>> m_trigrams; // Trigram to item indexes
+
         manCompDialog m_mcDialog;
 
         ItemLibrary m_itemLibrary;
@@ -39,6 +39,7 @@
 #include "ellipse.h"
 #include "esp01.h"
 #include "fixedvolt.h"
+#include "filesource.h"
 #include "flipflopd.h"
 #include "flipflopjk.h"
 #include "flipfloprs.h"
@@ -102,6 +103,7 @@
 #include "ssd1306.h"
 #include "stepper.h"
 #include "strain.h"
+#include "streamsource.h"
 #include "subcircuit.h"
 #include "subpackage.h"
 #include "switch.h"
@@ -151,6 +153,8 @@ void ItemLibrary::loadItems()
     addItem( FixedVolt::libraryItem() );
     addItem( Clock::libraryItem() );
     addItem( WaveGen::libraryItem() );
+    addItem( FileSource::libraryItem() );
+    addItem( StreamSource::libraryItem() );
     addItem( VoltSource::libraryItem() );
     addItem( CurrSource::libraryItem() );
     addItem( Csource::libraryItem() );
@@ -0,0 +1,239 @@
+/***************************************************************************
+ *   Copyright (C) 2020 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QDir>
+#include <QDebug>
+#include <string.h>
+
+#include "capturestore.h"
+
+CaptureStore::CaptureStore()
+{
+    m_file.setFileTemplate( QDir::tempPath()+"/simulide_XXXXXX.cap" );
+
+    m_chunkSize  = 4096;
+    m_fileSize   = 0;
+    m_samples    = 0;
+    m_dropped    = 0;
+    m_cacheIndex = -1;
+}
+CaptureStore::~CaptureStore()
+{
+    close();
+}
+
+bool CaptureStore::open() // Called at Simulation start
+{
+    close();
+    if( !m_file.open() ) { qDebug() << "CaptureStore::open Error: Can't create capture file"; return false; }
+    m_file.resize( 0 );
+
+    m_reader.setFileName( m_file.fileName() );
+    if( !m_reader.open( QIODevice::ReadOnly ) ) { m_file.close(); return false; }
+
+    m_chunks.clear();
+    m_pendTime.clear();
+    m_pendValue.clear();
+    m_tailTime.clear();
+    m_tailValue.clear();
+    m_pendTime.reserve( m_chunkSize );
+    m_pendValue.reserve( m_chunkSize );
+
+    m_fileSize   = 0;
+    m_samples    = 0;
+    m_dropped    = 0;
+    m_cacheIndex = -1;
+    return true;
+}
+
+void CaptureStore::close()
+{
+    if( m_reader.isOpen() ) m_reader.close();
+    if( m_file.isOpen() )   m_file.close();
+}
+
+void CaptureStore::commit() // Make pending samples visible to GUI
+{
+    QMutexLocker locker( &m_mutex );
+    m_tailTime  = m_pendTime;
+    m_tailValue = m_pendValue;
+}
+
+uint64_t CaptureStore::firstTime()
+{
+    QMutexLocker locker( &m_mutex );
+    if( m_chunks.size() )  return m_chunks.first().startTime;
+    if( m_tailTime.size() ) return m_tailTime.first();
+    return 0;
+}
+
+void CaptureStore::flush() // Compress pending samples and write chunk to file
+{
+    int count = m_pendTime.size();
+    if( !count ) return;
+    if( !m_file.isOpen() ) { dropPending(); return; }
+
+    uint64_t startTime = m_pendTime.first();
+    double minVal = m_pendValue.first();
+    double maxVal = minVal;
+
+    QByteArray raw;
+    raw.reserve( count*(8+3) );
+    uint64_t lastTime = startTime;
+    for( int i=0; i<count; ++i )
+    {
+        uint64_t delta = m_pendTime.at(i)-lastTime; // Delta encoded time (varint)
+        lastTime = m_pendTime.at(i);
+        while( delta > 0x7F ){ raw.append( (char)((delta & 0x7F) | 0x80) ); delta >>= 7; }
+        raw.append( (char)delta );
+
+        double value = m_pendValue.at(i);
+        raw.append( (const char*)&value, sizeof(double) );
+
+        if( value < minVal ) minVal = value;
+        if( value > maxVal ) maxVal = value;
+    }
+    QByteArray data = qCompress( raw, 1 );
+
+    m_file.seek( m_fileSize );
+    if( m_file.write( data ) != data.size() || !m_file.flush() ) // Disk full or file error: stop writing
+    {
+        qDebug() << "CaptureStore::flush Error: Can't write capture file, deep capture stopped";
+        m_file.close();
+        dropPending();
+        return;
+    }
+
+    chunk_t chunk = { startTime, lastTime, m_fileSize, data.size(), count, minVal, maxVal };
+    m_fileSize += data.size();
+    m_samples  += count;
+
+    m_mutex.lock();
+    m_chunks.append( chunk );
+    m_tailTime.clear();  // These samples are now in the chunk
+    m_tailValue.clear();
+    m_mutex.unlock();
+
+    m_pendTime.clear();
+    m_pendValue.clear();
+}
+
+void CaptureStore::dropPending() // Don't keep samples that can't be written
+{
+    m_dropped += m_pendTime.size();
+    m_pendTime.clear();
+    m_pendValue.clear();
+}
+
+void CaptureStore::readChunk( int index, QVector<uint64_t>* times, QVector<double>* values )
+{
+    if( m_cacheIndex != index )
+    {
+        m_cacheTime.clear();
+        m_cacheValue.clear();
+        m_cacheIndex = -1;
+
+        chunk_t chunk = m_chunks.at( index );
+        uchar* map = m_reader.map( chunk.offset, chunk.size );
+        if( !map ) return;
+        QByteArray raw = qUncompress( map, chunk.size );
+        m_reader.unmap( map );
+
+        m_cacheTime.reserve( chunk.count );
+        m_cacheValue.reserve( chunk.count );
+
+        const char* p   = raw.constData();
+        const char* end = p+raw.size();
+        uint64_t time = chunk.startTime;
+        while( p < end )
+        {
+            uint64_t delta = 0;
+            int shift = 0;
+            while( p < end ){
+                uint8_t byte = *p++;
+                delta |= (uint64_t)(byte & 0x7F) << shift;
+                if( !(byte & 0x80) ) break;
+                shift += 7;
+            }
+            if( p+sizeof(double) > end ) break;
+            double value;
+            memcpy( &value, p, sizeof(double) );
+            p += sizeof(double);
+
+            time += delta;
+            m_cacheTime.append( time );
+            m_cacheValue.append( value );
+        }
+        m_cacheIndex = index;
+    }
+    times->append( m_cacheTime );
+    values->append( m_cacheValue );
+}
+
+int CaptureStore::chunkCount()
+{
+    QMutexLocker locker( &m_mutex );
+    return m_chunks.size()+1;
+}
+
+void CaptureStore::getChunk( int index, QVector<uint64_t>* times, QVector<double>* values )
+{
+    QMutexLocker locker( &m_mutex );
+    times->clear();
+    values->clear();
+
+    if( index < m_chunks.size() ) readChunk( index, times, values );
+    else if( index == m_chunks.size() ){
+        times->append( m_tailTime );
+        values->append( m_tailValue );
+}   }
+
+void CaptureStore::getSamples( uint64_t t0, uint64_t t1, QVector<uint64_t>* times, QVector<double>* values, int maxChunks )
+{
+    QMutexLocker locker( &m_mutex );
+
+    QVector<uint64_t> rTime;
+    QVector<double>   rValue;
+
+    int size = m_chunks.size();
+    int first = 0;
+    int last  = size;
+    while( first < last ) // First chunk ending at or after t0
+    {
+        int mid = (first+last)/2;
+        if( m_chunks.at( mid ).endTime < t0 ) first = mid+1;
+        else                                  last  = mid;
+    }
+    if( first > 0 ) first--; // Include last sample before t0
+
+    last = first;
+    while( last < size && m_chunks.at( last ).startTime <= t1 ) last++;
+
+    if( last-first > maxChunks ) // Too many chunks: use chunk min/max values
+    {
+        for( int i=first; i<last; ++i )
+        {
+            chunk_t chunk = m_chunks.at(i);
+            rTime.append( chunk.startTime ); rValue.append( chunk.minVal );
+            rTime.append( chunk.endTime );   rValue.append( chunk.maxVal );
+        }
+    }
+    else for( int i=first; i<last; ++i ) readChunk( i, &rTime, &rValue );
+
+    rTime.append( m_tailTime );
+    rValue.append( m_tailValue );
+
+    int start = 0;
+    for( int i=0; i<rTime.size(); ++i ) // Last sample before t0
+    {
+        if( rTime.at(i) >= t0 ) break;
+        start = i;
+    }
+    for( int i=start; i<rTime.size(); ++i )
+    {
+        if( rTime.at(i) > t1 ) break;
+        times->append( rTime.at(i) );
+        values->append( rValue.at(i) );
+}   }
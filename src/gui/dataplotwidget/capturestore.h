@@ -0,0 +1,91 @@
+/***************************************************************************
+ *   Copyright (C) 2020 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef CAPTURESTORE_H
+#define CAPTURESTORE_H
+
+#include <QTemporaryFile>
+#include <QVector>
+#include <QMutex>
+
+// Disk backed sample store for long captures.
+// Samples are grouped in chunks, time is delta encoded and
+// each chunk is compressed and appended to a temporary file.
+// Chunks are read back through memory mapping when needed.
+//
+// addSample() is called from Simulation thread,
+// commit() only when Simulation thread is stopped (updateStep),
+// getSamples() from GUI thread at any time.
+
+class CaptureStore
+{
+    public:
+        CaptureStore();
+        ~CaptureStore();
+
+        bool open();
+        void close();
+        bool isOpen() { return m_file.isOpen(); }
+
+        inline void addSample( uint64_t time, double value )
+        {
+            if( m_pendTime.size() && m_pendTime.last() == time ) // Same time: overwrite value
+            { m_pendValue.last() = value; return; }
+
+            m_pendTime.append( time );
+            m_pendValue.append( value );
+            if( m_pendTime.size() >= m_chunkSize ) flush();
+        }
+        void commit();
+
+        uint64_t samples() { return m_samples; }
+        uint64_t dropped() { return m_dropped; } // Samples lost on file errors
+        uint64_t firstTime();
+
+        // Samples in range [t0,t1] plus last sample before t0.
+        // If range covers more than maxChunks chunks, min/max pairs per chunk are returned.
+        void getSamples( uint64_t t0, uint64_t t1, QVector<uint64_t>* times, QVector<double>* values, int maxChunks=64 );
+
+        // Sequential access: chunks on disk plus pending samples as last chunk.
+        int  chunkCount();
+        void getChunk( int index, QVector<uint64_t>* times, QVector<double>* values );
+
+    private:
+        struct chunk_t{
+            uint64_t startTime;
+            uint64_t endTime;
+            qint64   offset;
+            int      size;
+            int      count;
+            double   minVal;
+            double   maxVal;
+        };
+
+        void flush();
+        void dropPending();
+        void readChunk( int index, QVector<uint64_t>* times, QVector<double>* values );
+
+        QTemporaryFile m_file; // Written from Simulation thread
+        QFile m_reader;        // Mapped from GUI thread
+
+        QVector<chunk_t> m_chunks;      // Chunk index
+        QVector<uint64_t> m_pendTime;   // Chunk being filled
+        QVector<double>   m_pendValue;
+        QVector<uint64_t> m_tailTime;   // Copy of pending samples visible to GUI
+        QVector<double>   m_tailValue;
+
+        int      m_chunkSize;
+        qint64   m_fileSize;
+        uint64_t m_samples;
+        uint64_t m_dropped;
+
+        int m_cacheIndex;               // Last chunk decoded
+        QVector<uint64_t> m_cacheTime;
+        QVector<double>   m_cacheValue;
+
+        QMutex m_mutex;
+};
+
+#endif
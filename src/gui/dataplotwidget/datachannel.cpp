@@ -4,8 +4,11 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <QtMath>
+#include <QDataStream>
+#include <string.h>
 
 #include "datachannel.h"
+#include "capturestore.h"
 #include "plotdisplay.h"
 #include "plotbase.h"
 #include "simulator.h"
@@ -22,16 +25,34 @@ DataChannel::DataChannel( PlotBase* plotBase, QString id )
     m_ePin[1] = NULL;
     m_chTunnel = "";
     m_trigIndex = 0;
+    m_trigTime  = 0;
     m_pauseOnCond = false;
+    m_capture = nullptr;
+    m_pyrCounter = -1;
+    m_pyrTime = 0;
+    m_pyrValue = 0;
+    m_dataVersion = 0;
+}
+DataChannel::~DataChannel()
+{
+    if( m_capture ) delete m_capture;
 }
-DataChannel::~DataChannel(){}
 
 void DataChannel::stamp()    // Called at Simulation Start
 {
     m_bufferCounter = 0;
     m_trigIndex = 0;
+    m_trigTime  = 0;
     bool connected = false;
 
+    if( m_capture && !m_capture->open() ) // Can't write to disk: use only circular buffer
+    {
+        delete m_capture;
+        m_capture = nullptr;
+        Simulator::self()->setWarning( 3 );
+    }
+    resetPyramid();
+
     eNode* enode =  m_ePin[0]->getEnode();
     if( enode ){
         enode->voltChangedCallback( this );
@@ -43,6 +64,141 @@ void DataChannel::stamp()    // Called at Simulation Start
     m_ePin[1]->changeCallBack( this );
 }
 
+void DataChannel::saveState( QDataStream& out ) // Deep Capture file is not included
+{
+    QByteArray time( (const char*)m_time.constData(), m_time.size()*sizeof(uint64_t) );
+    out << m_buffer << time << (qint32)m_bufferCounter << (qint32)m_trigIndex
+        << m_rising << m_falling << (quint64)m_risEdge << (quint64)m_period;
+}
+
+void DataChannel::loadState( QDataStream& in )
+{
+    QVector<double>   buffer;
+    QByteArray time;
+    qint32 bufferCounter, trigIndex;
+    quint64 risEdge, period;
+    in >> buffer >> time >> bufferCounter >> trigIndex
+       >> m_rising >> m_falling >> risEdge >> period;
+
+    if( buffer.size() != m_buffer.size() || time.size() != m_time.size()*(int)sizeof(uint64_t) ) return; // Buffer size changed
+    m_buffer = buffer;
+    memcpy( m_time.data(), time.constData(), time.size() );
+    m_bufferCounter = bufferCounter;
+    setTrigIndex( trigIndex );
+    m_risEdge = risEdge;
+    m_period  = period;
+    resetPyramid();
+}
+
+void DataChannel::setDeepCapture( bool d )
+{
+    if( d == (m_capture != nullptr) ) return;
+    if( d ) m_capture = new CaptureStore();
+    else{
+        delete m_capture;
+        m_capture = nullptr;
+}   }
+
+void DataChannel::commitData()
+{
+    if( m_capture ) m_capture->commit();
+    updatePyramid();
+}
+
+void DataChannel::updatePyramid() // Called when Simulation thread is stopped
+{
+    int size = m_buffer.size();
+    if( size < 2 ) return;
+
+    int first = m_pyrCounter;
+    int last  = m_bufferCounter;
+
+    bool rebuild = (m_pyrCounter < 0) || (m_pyrCounter >= size)
+                || (m_minLevel.isEmpty()) || (m_minLevel.first().size() != (size+1)/2)
+                || (m_time.at( m_pyrCounter ) != m_pyrTime ); // Buffer overwritten since last update
+    if( rebuild )
+    {
+        m_minLevel.clear();
+        m_maxLevel.clear();
+        for( int n=(size+1)/2; ; n=(n+1)/2 )
+        {
+            m_minLevel.append( QVector<double>( n ) );
+            m_maxLevel.append( QVector<double>( n ) );
+            if( n == 1 ) break;
+        }
+        first = 0;
+        last  = size-1;
+    }
+    else if( first == last && m_buffer.at( last ) == m_pyrValue ) return; // No new data
+
+    m_pyrCounter = m_bufferCounter;
+    m_pyrTime    = m_time.at( m_bufferCounter );
+    m_pyrValue   = m_buffer.at( m_bufferCounter );
+    m_dataVersion++;
+
+    if( first > last ) // Wrapped around: update in 2 ranges
+    {
+        updateLevels( first, size-1 );
+        first = 0;
+    }
+    updateLevels( first, last );
+}
+
+void DataChannel::updateLevels( int first, int last )
+{
+    int size = m_buffer.size();
+    for( int l=0; l<m_minLevel.size(); ++l )
+    {
+        first >>= 1;
+        last  >>= 1;
+        QVector<double>& minL = m_minLevel[l];
+        QVector<double>& maxL = m_maxLevel[l];
+
+        for( int j=first; j<=last; ++j )
+        {
+            int i0 = j*2;
+            int i1 = i0+1;
+            double min, max;
+            if( l == 0 )
+            {
+                min = max = m_buffer.at( i0 );
+                if( i1 < size ){
+                    double v = m_buffer.at( i1 );
+                    if( v < min ) min = v;
+                    if( v > max ) max = v;
+            }   }
+            else{
+                min = m_minLevel.at( l-1 ).at( i0 );
+                max = m_maxLevel.at( l-1 ).at( i0 );
+                if( i1 < m_minLevel.at( l-1 ).size() ){
+                    double v = m_minLevel.at( l-1 ).at( i1 );
+                    if( v < min ) min = v;
+                    v = m_maxLevel.at( l-1 ).at( i1 );
+                    if( v > max ) max = v;
+            }   }
+            minL[j] = min;
+            maxL[j] = max;
+}   }   }
+
+void DataChannel::getMinMax( int first, int last, double* min, double* max )
+{
+    int levels = m_minLevel.size();
+    while( first <= last )
+    {
+        int l = 0; // Biggest aligned block starting at first and ending before last
+        while( l < levels && !(first & ((2<<l)-1)) && (first+(2<<l)-1 <= last) ) l++;
+
+        double vMin, vMax;
+        if( l == 0 ) vMin = vMax = m_buffer.at( first );
+        else{
+            vMin = m_minLevel.at( l-1 ).at( first>>l );
+            vMax = m_maxLevel.at( l-1 ).at( first>>l );
+        }
+        if( vMin < *min ) *min = vMin;
+        if( vMax > *max ) *max = vMax;
+        first += 1<<l;
+}   }
+
 bool DataChannel::isBus()
 {
     if( m_pin ) return m_pin->isBus();
@@ -107,3 +263,58 @@ void DataChannel::setTestData( QString td )
         m_bufferTest.append( dataPair.last().toDouble() );
     }
 }
+
+//----------------------------------------------------------
+// CLASS SampleCursor
+
+SampleCursor::SampleCursor( DataChannel* channel )
+{
+    m_channel = channel;
+    m_index = -1;
+    m_chunk = 0;
+    m_chunks = 0;
+
+    int size = channel->m_buffer.size();
+    m_oldest = channel->m_bufferCounter+1;
+    if( m_oldest >= size ) m_oldest = 0;
+
+    m_fromCapture = false;
+    CaptureStore* capture = channel->capture();
+    if( capture && size )
+    {
+        uint64_t oldestTime = channel->m_time.at( m_oldest );
+        uint64_t firstTime  = capture->firstTime();
+        m_fromCapture = firstTime && oldestTime && (firstTime < oldestTime);
+        if( m_fromCapture ) m_chunks = capture->chunkCount();
+    }
+    m_valid = true;
+    next();
+}
+
+void SampleCursor::next()
+{
+    if( !m_valid ) return;
+    if( m_fromCapture )
+    {
+        while( ++m_index >= m_cTime.size() ) // Load next chunk
+        {
+            if( m_chunk >= m_chunks ) { m_valid = false; return; }
+            m_channel->capture()->getChunk( m_chunk++, &m_cTime, &m_cValue );
+            m_index = -1;
+        }
+        m_sTime  = m_cTime.at( m_index );
+        m_sValue = m_cValue.at( m_index );
+        return;
+    }
+    int size = m_channel->m_buffer.size();
+    while( ++m_index < size )
+    {
+        int i = m_oldest+m_index;
+        if( i >= size ) i -= size;
+        m_sTime = m_channel->m_time.at(i);
+        if( m_sTime == 0 ) continue;                 // Empty samples: Simulation times start at 1 ps
+        m_sValue = m_channel->m_buffer.at(i);
+        return;
+    }
+    m_valid = false;
+}
@@ -20,10 +20,12 @@ enum cond_t{
 };
 
 class PlotBase;
+class CaptureStore;
 class Pin;
 
 class DataChannel : public eElement, public Updatable
 {
+        friend class SampleCursor;
         friend class PlotBase;
         friend class Oscope;
         friend class LAnalizer;
@@ -36,6 +38,9 @@ class DataChannel : public eElement, public Updatable
 
         virtual void stamp() override;
 
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
+
         virtual void setFilter( double f ) {;}
 
         bool isBus();
@@ -48,18 +53,44 @@ class DataChannel : public eElement, public Updatable
         QString testData();
         void setTestData( QString td );
 
+        void setDeepCapture( bool d );
+        CaptureStore* capture() { return m_capture; }
+        void commitData();
+
+        // Min/Max decimation pyramid over the circular buffer
+        void resetPyramid() { m_pyrCounter = -1; }
+        void updatePyramid();
+        void getMinMax( int first, int last, double* min, double* max ); // Buffer indexes, first <= last
+        uint64_t dataVersion() { return m_dataVersion; }
+
+        void setTrigIndex( int index ) // Called when Simulation thread is stopped
+        {
+            m_trigIndex = index;
+            m_trigTime = ( index >= 0 && index < m_time.size() ) ? m_time.at( index ) : 0;
+        }
+
     protected:
+        void updateLevels( int first, int last );
+
         QVector<double> m_buffer;
         QVector<uint64_t> m_time;
 
         QVector<double> m_bufferTest;
         QVector<uint64_t> m_timeTest;
 
+        QVector<QVector<double>> m_minLevel; // Level n: min of 2^(n+1) samples
+        QVector<QVector<double>> m_maxLevel; // Level n: max of 2^(n+1) samples
+        int      m_pyrCounter;  // Last buffer index included in pyramid
+        uint64_t m_pyrTime;     // Time at m_pyrCounter when included
+        double   m_pyrValue;    // Value at m_pyrCounter when included
+        uint64_t m_dataVersion;
+
         bool m_connected;
         bool m_rising;
         bool m_falling;
         bool m_trigger;
         int m_trigIndex;
+        uint64_t m_trigTime; // Time at m_trigIndex: newer samples are being written
 
         uint64_t m_risEdge;
         uint64_t m_period;
@@ -72,9 +103,42 @@ class DataChannel : public eElement, public Updatable
 
         QString m_chTunnel;
 
+        CaptureStore* m_capture; // Deep capture, nullptr if not used
+
         Pin* m_pin;
 
         PlotBase* m_plotBase;
 };
 
+// Reads channel samples in time order, from Deep Capture if
+// it holds older data than the circular buffer, or from the buffer.
+
+class SampleCursor
+{
+    public:
+        SampleCursor( DataChannel* channel );
+
+        bool     valid() { return m_valid; }
+        uint64_t time()  { return m_sTime; }
+        double   value() { return m_sValue; }
+        void next();
+
+    private:
+        DataChannel* m_channel;
+
+        bool m_valid;
+        bool m_fromCapture;
+
+        uint64_t m_sTime;
+        double   m_sValue;
+
+        int m_index;  // Buffer logical index or index in chunk
+        int m_oldest; // Buffer index of oldest sample
+        int m_chunk;
+        int m_chunks;
+
+        QVector<uint64_t> m_cTime; // Current chunk
+        QVector<double>   m_cValue;
+};
+
 #endif
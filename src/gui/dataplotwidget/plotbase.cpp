@@ -29,6 +29,7 @@ PlotBase::PlotBase( QString type, QString id )
 
     m_connectGnd = true;
     m_inputAdmit = 1e-7;
+    m_deepCapture = false;
 
     m_doTest = false;
     m_testTime = 0;
@@ -80,6 +81,9 @@ PlotBase::PlotBase( QString type, QString id )
         new IntProp <PlotBase>("BufferSize",tr("Buffer Size"),""
                               , this, &PlotBase::bufferSize, &PlotBase::setBufferSize,0,"uint" ),
 
+        new BoolProp<PlotBase>("DeepCapture",tr("Deep Capture to disk"),""
+                              , this, &PlotBase::deepCapture, &PlotBase::setDeepCapture,0 ),
+
         new BoolProp<PlotBase>("connectGnd",tr("Connect to ground"),""
                               , this, &PlotBase::connectGnd, &PlotBase::setConnectGnd,0 ),
 
@@ -205,6 +209,13 @@ void PlotBase::setBufferSize( int bs )
     }
 }
 
+void PlotBase::setDeepCapture( bool d )
+{
+    if( Simulator::self()->isRunning() ) CircuitWidget::self()->powerCircOff();
+    m_deepCapture = d;
+    for( int i=0; i<m_numChannels; i++ ) m_channel[i]->setDeepCapture( d );
+}
+
 void PlotBase::setConnectGnd( bool c )
 {
     if( m_connectGnd == c ) return;
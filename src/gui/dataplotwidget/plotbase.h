@@ -34,6 +34,9 @@ class PlotBase : public Component, public ScriptBase
         int bufferSize() { return m_bufferSize; }
         void setBufferSize( int bs );
 
+        bool deepCapture() { return m_deepCapture; }
+        void setDeepCapture( bool d );
+
         bool connectGnd() { return m_connectGnd; }
         void setConnectGnd( bool c );
 
@@ -134,6 +137,7 @@ class PlotBase : public Component, public ScriptBase
         bool m_autoExport;
         QString m_exportFile;
 
+        bool m_deepCapture;
         bool m_connectGnd;
         double m_inputAdmit;
 
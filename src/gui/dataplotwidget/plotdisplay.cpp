@@ -3,6 +3,7 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <cstdint>
 #include <QtMath>
 #include <QMouseEvent>
 #include <QBrush>
@@ -10,6 +11,7 @@
 
 #include "plotdisplay.h"
 #include "datachannel.h"
+#include "capturestore.h"
 #include "plotbase.h"
 #include "mainwindow.h"
 #include "circuitview.h"
@@ -31,6 +33,8 @@ PlotDisplay::PlotDisplay( QWidget* parent )
         m_vMin[i] = 0;
         m_channel[i] = NULL;
         m_hideCh[i] = false;
+        m_pathVersion[i] = UINT64_MAX; // No path built yet
+        for( int k=0; k<6; ++k ) m_pathKey[i][k] = 0;
     }
     m_sizeX = 135;
     m_sizeY = 135;
@@ -188,6 +192,85 @@ void PlotDisplay::drawBackground( QPainter* p )
         p->drawLine( m_hCenter, m_ceroY, m_hCenter, m_endY );    //Vertical Center line
 }   }
 
+int PlotDisplay::lowerBound( int ch, int oldest, int lo, int hi, double time ) // First sample at or after time
+{
+    QVector<uint64_t>* timeData = &m_channel[ch]->m_time;
+    uint64_t trigTime = m_channel[ch]->m_trigTime;
+    int size = timeData->size();
+    while( lo < hi )
+    {
+        int mid = (lo+hi)/2;
+        uint64_t t = timeData->at( (oldest+mid)%size );
+        // Simulation thread overwrites oldest samples with times after trigTime:
+        // skip them as if they were before time, so search range stays sorted.
+        if( t < time || t > trigTime ) lo = mid+1;
+        else                           hi = mid;
+    }
+    return lo;
+}
+
+void PlotDisplay::drawDecimated( QPainter* p, int ch, int oldest, int first, int last, double tOrigin )
+{
+    DataChannel* channel = m_channel[ch];
+    QVector<double>* voltData = &channel->m_buffer;
+    int size = voltData->size();
+
+    double key[6] = { tOrigin, m_scaleX, m_scaleY[ch], m_posY[ch], m_ceroX, m_endX };
+    bool valid = ( m_pathVersion[ch] == channel->dataVersion() );
+    for( int k=0; k<6; ++k ){
+        if( m_pathKey[ch][k] == key[k] ) continue;
+        m_pathKey[ch][k] = key[k];
+        valid = false;
+    }
+    if( !valid ) // Data or Zoom changed: build plot from Min/Max pyramid
+    {
+        m_pathVersion[ch] = channel->dataVersion();
+        m_pathMax[ch] = -1e12;
+        m_pathMin[ch] =  1e12;
+
+        double posY   = m_posY[ch];
+        double scaleY = m_scaleY[ch];
+        int index = first;
+        double volt = voltData->at( (oldest+(first > 0 ? first-1 : first))%size ); // Value at screen start
+
+        QPainterPath path;
+        path.moveTo( m_ceroX, posY-volt*scaleY );
+        for( double x=m_ceroX; x<m_endX; x+=1 )
+        {
+            int next = lowerBound( ch, oldest, index, last+1, tOrigin+(x+1-m_ceroX)/m_scaleX );
+            path.lineTo( x, posY-volt*scaleY );
+            if( next == index ) continue;
+
+            double min = 1e12;
+            double max =-1e12;
+            int i0 = (oldest+index)%size;  // Samples in this pixel
+            int i1 = (oldest+next-1)%size;
+            if( i0 <= i1 ) channel->getMinMax( i0, i1, &min, &max );
+            else{
+                channel->getMinMax( i0, size-1, &min, &max );
+                channel->getMinMax( 0, i1, &min, &max );
+            }
+            if( max > m_pathMax[ch] ) m_pathMax[ch] = max;
+            if( min < m_pathMin[ch] ) m_pathMin[ch] = min;
+
+            volt = voltData->at( i1 );
+            path.lineTo( x, posY-min*scaleY );
+            path.lineTo( x, posY-max*scaleY );
+            path.lineTo( x, posY-volt*scaleY );
+            index = next;
+        }
+        path.lineTo( m_endX, posY-volt*scaleY );
+        m_path[ch] = path;
+    }
+    m_vMaxVal[ch] = m_pathMax[ch];
+    m_vMinVal[ch] = m_pathMin[ch];
+
+    p->save();
+    p->setBrush( Qt::NoBrush );
+    p->drawPath( m_path[ch] );
+    p->restore();
+}
+
 void PlotDisplay::paintEvent( QPaintEvent* /* event */ )
 {
     QPainter p( this );
@@ -226,6 +309,43 @@ void PlotDisplay::paintEvent( QPaintEvent* /* event */ )
         double timeStart = m_timeStart-m_hPos[i];
         if( timeStart < 0 ) timeStart = 0;
         double timeEnd = m_timeEnd-m_hPos[i];
+
+        QVector<double>   captVolt;
+        QVector<uint64_t> captTime;
+        CaptureStore* capture = m_channel[i]->capture();
+        if( capture && bufferSize ) // Deep Capture: read from disk if data not in buffer
+        {
+            int oldest = pos+1;
+            if( oldest >= bufferSize ) oldest = 0;
+            uint64_t oldestTime = timeData->at( oldest ); // 0 if buffer not full yet
+
+            if( oldestTime && timeStart < oldestTime )
+            {
+                capture->getSamples( timeStart, timeEnd, &captTime, &captVolt );
+                if( captTime.isEmpty() ) continue;
+                voltData = &captVolt;
+                timeData = &captTime;
+                bufferSize = captTime.size();
+                pos = bufferSize-1;
+        }   }
+        if( voltData == &m_channel[i]->m_buffer && bufferSize > 1 && !m_channel[i]->isBus() )
+        {
+            int oldest = pos+1;
+            if( oldest >= bufferSize ) oldest = 0;
+            double tOrigin = m_timeStart-m_hPos[i];
+            int first = lowerBound( i, oldest, 0, bufferSize, timeStart );
+            int last  = lowerBound( i, oldest, first, bufferSize, timeEnd )-1;
+
+            if( last-first > 2*m_sizeX ) // More samples than pixels: use Min/Max pyramid
+            {
+                drawDecimated( &p, i, oldest, first, last, tOrigin );
+                if( drawCursor ){
+                    int c = lowerBound( i, oldest, first, last+1, tOrigin+(cursorX-m_ceroX)/m_scaleX )-1;
+                    if( c < 0 ) c = 0;
+                    m_cursorVolt[i] = voltData->at( (oldest+c)%bufferSize );
+                }
+                continue;
+        }   }
         double time, x1, x2, y1, y2;
         double p1Volt=0;//, p2Volt=0;
         QPointF P1, P2, Pm;
@@ -8,6 +8,7 @@
 
 #include <QPixmap>
 #include <QWidget>
+#include <QPainterPath>
 
 class DataChannel;
 class PlotBase;
@@ -53,6 +54,8 @@ class PlotDisplay : public QWidget
 
     private:
         inline void drawBackground( QPainter* p );
+        void drawDecimated( QPainter* p, int ch, int oldest, int first, int last, double tOrigin );
+        int lowerBound( int ch, int oldest, int lo, int hi, double time );
 
         PlotBase*    m_component;
         DataChannel* m_channel[8];
@@ -97,6 +100,12 @@ class PlotDisplay : public QWidget
         bool   m_hideCh[8];
         bool   m_ncCh[8];
 
+        QPainterPath m_path[8]; // Cached decimated plots
+        uint64_t m_pathVersion[8];
+        double   m_pathKey[8][6];
+        double   m_pathMax[8];
+        double   m_pathMin[8];
+
         QFont m_fontB;
         QFont m_fontXS;
         QFont m_fontS;
@@ -20,6 +20,7 @@ BaseDebugger::BaseDebugger( CodeEditor* parent, OutPanelText* outPane )
     m_compName = "None";
     m_langLevel = 0;
     m_lstType = 0;
+    m_lastLine = -1;
 
     m_appPath = QCoreApplication::applicationDirPath();
 }
@@ -215,11 +216,13 @@ bool BaseDebugger::postProcess()
 void BaseDebugger::run()
 {
     m_running = true;
+    createBrkMap();
     stepFromLine();
 }
 
 void BaseDebugger::pause()
 {
+    if( m_running && m_lastLine >= 0 ) m_prevLine = m_lines[m_lastLine]; // Line reached at full speed
     m_running = false;
     m_debugStep = false;
     EditorWindow::self()->pauseAt( m_prevLine );
@@ -278,6 +281,74 @@ void BaseDebugger::stepDebug()
                 EditorWindow::self()->lineReached( line );
 }   }   }   }
 
+void BaseDebugger::remBreakLine( codeLine_t line ) // Breakpoint removed while running
+{
+    // Simulation thread is reading the map: only clear entries, don't rebuild it
+    for( auto it=m_flashToSource.constBegin(); it!=m_flashToSource.constEnd(); ++it )
+    {
+        int addr = it.key();
+        if( addr < 0 || (uint)addr >= m_brkAddr.size() ) continue;
+        if( line == it.value() ) m_brkAddr[addr] = 0;
+    }
+}
+
+void BaseDebugger::createBrkMap() // Map breakpoints to flash addresses
+{
+    uint size = eMcu::self()->flashSize();
+    m_addrLine.assign( size, -1 );
+    m_brkAddr.assign( size, 0 );
+    m_lines.clear();
+    m_brkConds.clear();
+
+    QHash<QString, int> lineIndex;
+    for( auto it=m_flashToSource.constBegin(); it!=m_flashToSource.constEnd(); ++it )
+    {
+        int addr = it.key();
+        if( addr < 0 || (uint)addr >= size ) continue;
+
+        codeLine_t line = it.value();
+        QString key = line.file+":"+QString::number( line.lineNumber );
+        int index = lineIndex.value( key, -1 );
+        if( index < 0 )
+        {
+            index = m_lines.size();
+            lineIndex[key] = index;
+            m_lines.push_back( line );
+        }
+        m_addrLine[addr] = index;
+
+        QList<int>* brkPoints = EditorWindow::self()->getBreakPoints( line.file );
+        if( !brkPoints || !brkPoints->contains( line.lineNumber ) ) continue;
+        m_brkAddr[addr] = 1;
+
+        QString cond = EditorWindow::self()->getBreakCond( line );
+        if( cond.isEmpty() || m_brkConds.contains( index ) ) continue;
+        dataCond_t c;
+        if( eMcu::self()->parseCond( cond, &c ) ) m_brkConds[index] = c;
+        else m_outPane->appendLine( tr("Warning: Invalid breakpoint condition at line ")
+                                    +QString::number( line.lineNumber )+": "+cond );
+    }
+    uint PC = eMcu::self()->cpu()->getPC();
+    m_lastLine = (PC < size) ? m_addrLine[PC] : -1; // Don't break in current line
+}
+
+void BaseDebugger::breakReached()
+{
+    if( m_brkConds.size() ) // Conditions only evaluated when address has breakpoint
+    {
+        auto it = m_brkConds.constFind( m_lastLine );
+        if( it != m_brkConds.constEnd() && !eMcu::self()->evalCond( it.value() ) ) return;
+    }
+    m_prevLine = m_lines[m_lastLine];
+    EditorWindow::self()->pause();
+}
+
+void BaseDebugger::watchReached( QString msg )
+{
+    m_outPane->appendLine( msg );
+    EditorWindow::self()->pause();
+}
+
 QString BaseDebugger::getValueInFile( QString line, QString key ) // Static
 {
     QString lineL = line.toLower();
@@ -7,8 +7,10 @@
 #define BASEDEBUGGER_H
 
 #include <QHash>
+#include <vector>
 
 #include "compiler.h"
+#include "mcudataspace.h"
 
 struct codeLine_t{
     QString file;
@@ -34,10 +36,20 @@ class BaseDebugger : public Compiler    // Base Class for all debuggers
         bool stepFromLine( bool over=false );
         void stepDebug();
 
+        inline void runStep( uint pc ) // Run to breakpoint: called after each cpu step at full speed
+        {
+            if( pc >= m_addrLine.size() ) return;
+            int line = m_addrLine[pc];
+            if( line < 0 || line == m_lastLine ) return;
+            m_lastLine = line;
+            if( m_brkAddr[pc] ) breakReached();
+        }
+
         void setLstType( int type ) { m_lstType = type; }
         void setLangLevel( int level ) { m_langLevel = level; }
 
         void setLineToFlash( codeLine_t line, int addr );
+        void remBreakLine( codeLine_t line );
 
         int getValidLine( codeLine_t pc );
         bool isMappedLine( codeLine_t line );
@@ -56,6 +68,10 @@ class BaseDebugger : public Compiler    // Base Class for all debuggers
 
         bool isNoValid( QString line );
 
+        void createBrkMap();
+        void breakReached();
+        void watchReached( QString msg );
+
         bool m_debugStep;
         bool m_running;
         bool m_over;
@@ -79,6 +95,12 @@ class BaseDebugger : public Compiler    // Base Class for all debuggers
         //QHash<int, int> m_sourceToFlash;        // Map Source code line to flash adress
         QHash<QString, int> m_functions;        // Function name list->start Address
         QList<int>          m_funcAddr;         // Function start Address list
+
+        std::vector<codeLine_t> m_lines;     // Mapped source lines
+        std::vector<int>        m_addrLine;  // Flash address to index in m_lines, -1 if not mapped
+        std::vector<uint8_t>    m_brkAddr;   // Flash address has a breakpoint
+        int m_lastLine;                      // Index in m_lines of last line reached
+        QHash<int, dataCond_t> m_brkConds;   // Conditional breakpoints by index in m_lines
 };
 
 #endif
@@ -9,6 +9,7 @@
 #include <QAbstractItemView>
 #include <QStringListModel>
 #include <QScrollBar>
+#include <QInputDialog>
 #include <QDebug>
 
 #include "codeeditor.h"
@@ -47,6 +48,7 @@ CodeEditor::CodeEditor( QWidget* parent, OutPanelText* outPane )
 
     m_outPane   = outPane;
     m_lNumArea  = new LineNumberArea( this );
+    m_lNumWidth = -1;
     m_hlighter  = new Highlighter( document() );
 
     m_saveAtClose  = false;
@@ -573,13 +575,40 @@ void CodeEditor::addBreakPoint( int line )
 
 void CodeEditor::remBreakPoint( int line )
 {
+    if( EditorWindow::self()->debugState() == DBG_RUNNING )
+        EditorWindow::self()->debugger()->remBreakLine( {m_file, line} );
+
     m_brkPoints.removeOne( line );
+    m_brkConds.remove( line );
     //QTextBlock block = document()->findBlockByNumber( line-1 );
     //UserData* data = (UserData*)block.userData();
     //data->breakp = false;
     update();
 }
 
+void CodeEditor::editBreakCond( int y ) // Breakpoint condition at line in position y of line number area
+{
+    int line = cursorForPosition( QPoint( 0, y ) ).blockNumber()+1;
+    if( EditorWindow::self()->debugState() == DBG_RUNNING ) return;
+    if( EditorWindow::self()->debugState() > DBG_STOPPED )
+        line = EditorWindow::self()->debugger()->getValidLine( {m_file, line} );
+    if( line <= 0 ) return;
+
+    bool ok = false;
+    QString cond = QInputDialog::getText( this, tr("Breakpoint Condition"),
+                   tr("Break at line %1 if (ex: PORTB == 0x10, count > 5, FLAGS & 4):").arg( line ),
+                   QLineEdit::Normal, m_brkConds.value( line ), &ok );
+    if( !ok ) return;
+
+    cond = cond.trimmed();
+    if( cond.isEmpty() ) m_brkConds.remove( line );
+    else{
+        m_brkConds[line] = cond;
+        addBreakPoint( line );
+    }
+    update();
+}
+
 void CodeEditor::startDebug()
 {
     setReadOnly( true );
@@ -837,11 +866,24 @@ int CodeEditor::lineNumberAreaWidth()
     return  fontMetrics().height() + fontMetrics().width( QLatin1Char( '9' ) ) * digits;
 }
 
+void CodeEditor::updateLineNumberAreaWidth( int )
+{
+    int width = lineNumberAreaWidth();
+    if( width == m_lNumWidth ) return; // Avoid relayout if width didn't change
+    m_lNumWidth = width;
+    setViewportMargins( width, 0, 0, 0 );
+}
+
 void CodeEditor::updateLineNumberArea( const QRect &rect, int dy )
 {
     if( dy ) m_lNumArea->scroll( 0, dy );
     else     m_lNumArea->update( 0, rect.y(), m_lNumArea->width(), rect.height() );
-    if( rect.contains( viewport()->rect() ) ) updateLineNumberAreaWidth( 0 );
+    if( rect.contains( viewport()->rect() ) )
+    {
+        updateLineNumberAreaWidth( 0 );
+        int lines = viewport()->height()/fontMetrics().height()+2;
+        m_hlighter->setVisibleBlocks( firstVisibleBlock().blockNumber(), lines );
+    }
 }
 
 void CodeEditor::resizeEvent( QResizeEvent* e )
@@ -905,6 +947,8 @@ void CodeEditor::lineNumberAreaPaintEvent( QPaintEvent* event )
         QList<int> errors    = m_errors;  // Copy lists to make substitutions
         QList<int> warnings  = m_warnings;
         QList<int> brkPoints = m_brkPoints;
+        QHash<int, QString> brkConds = m_brkConds;
+        QHash<int, QString> movedConds;
 
         while( block.isValid() )
         {
@@ -915,6 +959,7 @@ void CodeEditor::lineNumberAreaPaintEvent( QPaintEvent* event )
                 if( delta > 0 ) // Line removed, check if point at cursor line and remove it
                 {
                     if( m_brkPoints.contains( newLine ) ) brkPoints.removeOne( newLine );
+                    brkConds.remove( newLine );
                     if( m_errors.contains( newLine )    ) errors.removeOne( newLine );
                     if( m_warnings.contains( newLine )  ) warnings.removeOne( newLine );
                 }
@@ -923,6 +968,11 @@ void CodeEditor::lineNumberAreaPaintEvent( QPaintEvent* event )
             if( found ) // Replace lines
             {
                 if( m_brkPoints.contains( oldLine ) ) brkPoints.replace( m_brkPoints.indexOf( oldLine ), newLine ); // Replace breakpoint line
+                if( m_brkConds.contains( oldLine ) )
+                {
+                    movedConds[newLine] = m_brkConds.value( oldLine );                    // Move breakpoint condition
+                    brkConds.remove( oldLine );
+                }
                 if( m_errors.contains( oldLine )    ) errors.replace(    m_errors.indexOf( oldLine )   , newLine ); // Replace error line
                 if( m_warnings.contains( oldLine )  ) warnings.replace(  m_warnings.indexOf( oldLine ) , newLine ); // Replace warning line
             }
@@ -931,6 +981,8 @@ void CodeEditor::lineNumberAreaPaintEvent( QPaintEvent* event )
         m_errors    = errors;      // Replace old lists with new ones
         m_warnings  = warnings;
         m_brkPoints = brkPoints;
+        for( int line : movedConds.keys() ) brkConds[line] = movedConds.value( line );
+        m_brkConds = brkConds;
 
         block = firstVisibleBlock();
     }
@@ -1084,6 +1136,11 @@ void LineNumberArea::contextMenuEvent( QContextMenuEvent *event)
     connect( remBrkAction, &QAction::triggered,
                m_codeEditor, &CodeEditor::slotRemBreak, Qt::UniqueConnection );
 
+    int y = event->pos().y();
+    QAction* condBrkAction = menu.addAction( QIcon(":/breakpoint.png"),tr( "BreakPoint Condition..." ) );
+    connect( condBrkAction, &QAction::triggered,
+               m_codeEditor, [=](){ m_codeEditor->editBreakCond( y ); }, Qt::UniqueConnection );
+
     menu.addSeparator();
 
     QAction* clrBrkAction = menu.addAction( QIcon(":/remove.svg"),tr( "Clear All BreakPoints" ) );
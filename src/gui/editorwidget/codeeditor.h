@@ -7,6 +7,7 @@
 #define CODEEDITOR_H
 
 #include <QPlainTextEdit>
+#include <QHash>
 
 #include "compbase.h"
 
@@ -75,6 +76,8 @@ class CodeEditor : public QPlainTextEdit, public CompBase
         void addWarning( int w ) { if( !m_warnings.contains( w ) ) m_warnings.append( w );}
 
         QList<int>* getBreakPoints() { return &m_brkPoints; }
+        QString breakCond( int line ) { return m_brkConds.value( line ); }
+        void editBreakCond( int y );
         QList<int>* getErrors()      { return &m_errors; }
         QList<int>* getWarnings()    { return &m_warnings; }
 
@@ -103,11 +106,11 @@ class CodeEditor : public QPlainTextEdit, public CompBase
     public slots:
         void slotAddBreak() { m_brkAction = 1; }
         void slotRemBreak() { m_brkAction = 2; }
-        void slotClearBreak() { m_brkPoints.clear(); }
+        void slotClearBreak() { m_brkPoints.clear(); m_brkConds.clear(); }
         void insertCompletion( QString text );
 
     private slots:
-        void updateLineNumberAreaWidth(int) { setViewportMargins( lineNumberAreaWidth(), 0, 0, 0 ); }
+        void updateLineNumberAreaWidth( int );
         void updateLineNumberArea( const QRect &, int );
         void highlightCurrentLine();
         void deleteSelected();
@@ -128,6 +131,7 @@ class CodeEditor : public QPlainTextEdit, public CompBase
         OutPanelText* m_outPane;
 
         LineNumberArea* m_lNumArea;
+        int             m_lNumWidth;
         Highlighter*    m_hlighter;
 
         //QString m_prevWord;
@@ -143,6 +147,7 @@ class CodeEditor : public QPlainTextEdit, public CompBase
         QString m_help;
 
         QList<int> m_brkPoints;
+        QHash<int, QString> m_brkConds; // Breakpoint conditions by line
         QList<int> m_errors;
         QList<int> m_warnings;
 
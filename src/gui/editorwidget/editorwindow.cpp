@@ -210,6 +210,20 @@ void EditorWindow::lineReached( codeLine_t line ) // Processor reached PC relate
     pause();
 }
 
+QList<int>* EditorWindow::getBreakPoints( QString file )
+{
+    CodeEditor* ce = (CodeEditor*)m_fileList.value( file );
+    if( !ce ) return nullptr;
+    return ce->getBreakPoints();
+}
+
+QString EditorWindow::getBreakCond( codeLine_t line )
+{
+    CodeEditor* ce = (CodeEditor*)m_fileList.value( line.file );
+    if( !ce ) return "";
+    return ce->breakCond( line.lineNumber );
+}
+
 void EditorWindow::pauseAt( codeLine_t line )
 {
     m_debugLine = line;
@@ -43,6 +43,9 @@ class EditorWindow : public EditorWidget, public Updatable
         void lineReached( codeLine_t line );
         void pauseAt( codeLine_t line );
 
+        QList<int>* getBreakPoints( QString file );
+        QString getBreakCond( codeLine_t line );
+
         bebugState_t debugState() { return m_state; }
 
         BaseDebugger* createDebugger( QString name, CodeEditor* ce, QString code="" );
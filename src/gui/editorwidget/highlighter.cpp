@@ -4,6 +4,7 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <QtGui>
+#include <QElapsedTimer>
 
 #include "highlighter.h"
 #include "mainwindow.h"
@@ -13,6 +14,15 @@ Highlighter::Highlighter( QTextDocument* parent )
            : QSyntaxHighlighter( parent )
 { 
     m_multiline = false;
+
+    m_lazyStart   = 0;
+    m_lazyNext    = 0;
+    m_lazyWrapped = false;
+    m_firstVisible = 0;
+    m_visibleCount = 0;
+
+    connect( &m_lazyTimer, &QTimer::timeout,
+                     this, &Highlighter::highlightNext, Qt::UniqueConnection );
 }
 Highlighter::~Highlighter(){}
 
@@ -86,20 +96,23 @@ QStringList Highlighter::readSyntaxFile( QString fileName )
                         QString exp = words.takeFirst();
                         exp = remQuotes( exp );
                         m_multiStart.setPattern( exp.replace("\\\\","\\") );
+                        m_multiStart.optimize();
                         exp = words.takeFirst();
                         exp = remQuotes( exp );
                         m_multiEnd.setPattern( exp.replace("\\\\","\\")  );
+                        m_multiEnd.optimize();
                 }   }
                 else{
-                    for( QString exp : words )  // Keywords
+                    QStringList lineWords;
+                    for( QString exp : words )
                     {
-                        if( exp.startsWith("\"")) exp = remQuotes( exp ); // RegExp
-                        else{
+                        if( exp.startsWith("\"")) addRule( format, remQuotes( exp ) ); // RegExp
+                        else{                                                          // Keyword
                             if( exp.length() > 2 ) keyWords.append( exp );
-                            exp = "\\b"+exp+"\\b";
-                        }
-                        addRule( format, exp );
-                }   }
+                            lineWords.append( exp );
+                    }   }
+                    addWords( &m_rules, format, lineWords ); // All keywords in one expression
+                }
                 format.setFontWeight( QFont::Normal );         // Reset to Defaults
                 format.setForeground( Qt::black );             // Reset to Defaults
             }
@@ -109,7 +122,7 @@ QStringList Highlighter::readSyntaxFile( QString fileName )
     addRule( format, QString( " " ) );
     addRule( format, QString( "\t" ) );
 
-    this->rehighlight();
+    rehighlightLazy();
 
     return keyWords;
 }
@@ -121,9 +134,9 @@ void Highlighter::addObjects( QStringList patterns )
     f.setFontWeight( QFont::Bold );
     f.setForeground( QColor( 0, 120, 70 ) );
     
-    for( QString exp : patterns ) m_objectRules.append( HighlightRule{ QRegExp( "\\b"+exp+"\\b"), f } );
+    addWords( &m_objectRules, f, patterns );
 
-    this->rehighlight();
+    rehighlightLazy();
 }
 
 void Highlighter::setMembers( QStringList patterns )
@@ -138,9 +151,9 @@ void Highlighter::addMembers( QStringList patterns )
     f.setFontWeight( QFont::Bold );
     f.setForeground( QColor( 0, 95, 160 ) );
 
-    for( QString exp : patterns ) m_memberRules.append( HighlightRule{ QRegExp( "\\b"+exp+"\\b"), f } );
+    addWords( &m_memberRules, f, patterns );
 
-    this->rehighlight();
+    rehighlightLazy();
 }
 
 void Highlighter::setExtraTypes( QStringList patterns )
@@ -150,59 +163,144 @@ void Highlighter::setExtraTypes( QStringList patterns )
     f.setFontWeight( QFont::Bold );
     f.setForeground( QColor( 0x904020 ) );
 
-    for( QString exp : patterns ) m_extraRules.append( HighlightRule{ QRegExp( "\\b"+exp+"\\b"), f } );
+    addWords( &m_extraRules, f, patterns );
 
-    this->rehighlight();
+    rehighlightLazy();
 }
 
 void Highlighter::highlightBlock( const QString &text )
 {
-    QString lcText = text;
-    lcText = lcText.toLower(); // Do case insensitive
-
     for( const HighlightRule &rule : m_objectRules ) processRule( rule, text );
     for( const HighlightRule &rule : m_memberRules ) processRule( rule, text );
     for( const HighlightRule &rule : m_extraRules  ) processRule( rule, text );
-    for( const HighlightRule &rule : m_rules       ) processRule( rule, lcText );
 
+    if( !m_rules.isEmpty() )
+    {
+        QString lcText = text.toLower(); // Do case insensitive
+        for( const HighlightRule &rule : m_rules ) processRule( rule, lcText );
+    }
     if( m_multiline )                              // Multiline comment:
     {
         setCurrentBlockState( 0 );
         int startIndex = 0;
         if( previousBlockState() != -10 )
-            startIndex = m_multiStart.indexIn( text );
+            startIndex = text.indexOf( m_multiStart );
 
         while( startIndex >= 0 )
         {
-            int endIndex = m_multiEnd.indexIn( text, startIndex );
+            QRegularExpressionMatch match = m_multiEnd.match( text, startIndex );
             int commentLength;
-            if( endIndex == -1 )
+            if( !match.hasMatch() )
             {
                 setCurrentBlockState( -10 );
                 commentLength = text.length()- startIndex;
             }else{
-                commentLength = endIndex - startIndex + m_multiEnd.matchedLength();
+                commentLength = match.capturedEnd() - startIndex;
             }
             setFormat( startIndex, commentLength, m_multiFormat );
-            startIndex = m_multiStart.indexIn( text, startIndex + commentLength );
+            if( commentLength == 0 ) break; // Empty expressions
+            startIndex = text.indexOf( m_multiStart, startIndex + commentLength );
 }   }   }
 
-void Highlighter::processRule( HighlightRule rule, QString lcText )
+inline void Highlighter::processRule( const HighlightRule &rule, const QString &text )
 {
-    QRegExp expression( rule.pattern );
-    int index = expression.indexIn( lcText );
-    while( index >= 0 )
+    QRegularExpressionMatchIterator it = rule.pattern.globalMatch( text );
+    while( it.hasNext() )
     {
-        int length = expression.matchedLength();
-        setFormat( index, length, rule.format );
-        index = expression.indexIn( lcText, index + length );
+        QRegularExpressionMatch match = it.next();
+        setFormat( match.capturedStart(), match.capturedLength(), rule.format );
 }   }
 
 void Highlighter::addRule( QTextCharFormat format, QString exp )
 {
     HighlightRule rule;
 
-    rule.pattern = QRegExp( exp );
+    rule.pattern = QRegularExpression( exp );
+    rule.pattern.optimize();
     rule.format = format;
     m_rules.append( rule );
 }
+
+void Highlighter::addWords( QVector<HighlightRule>* rules, QTextCharFormat format, QStringList words )
+{
+    if( words.isEmpty() ) return;
+
+    HighlightRule rule;  // One expression for all words: \b(?:w1|w2|...)\b
+    rule.pattern = QRegularExpression( "\\b(?:"+words.join("|")+")\\b" );
+    rule.format = format;
+
+    if( !rule.pattern.isValid() ) // Some word is not a valid expression: one rule per word
+    {
+        for( QString exp : words ) rules->append( HighlightRule{ QRegularExpression( "\\b"+exp+"\\b"), format } );
+        return;
+    }
+    rule.pattern.optimize();
+    rules->append( rule );
+}
+
+// Lazy rehighlight: changing rules doesn't rehighlight the whole document at once.
+// Visible blocks are highlighted first and then the rest in small steps
+// when the event loop is idle, so large files open without blocking the UI.
+
+void Highlighter::rehighlightLazy()
+{
+    if( !document() ) return;
+
+    m_lazyStart   = m_firstVisible;
+    m_lazyNext    = m_firstVisible;
+    m_lazyWrapped = false;
+    m_lazyDone.clear();
+    m_lazyTimer.start( 0 );
+}
+
+void Highlighter::setVisibleBlocks( int first, int count ) // Visible blocks are done first
+{
+    m_firstVisible = first;
+    m_visibleCount = count;
+}
+
+bool Highlighter::isHighlighted( int block )
+{
+    if( !m_lazyTimer.isActive() ) return true;
+    if( m_lazyDone.contains( block ) ) return true;
+    if( m_lazyWrapped ) return block >= m_lazyStart || block < m_lazyNext;
+    return block >= m_lazyStart && block < m_lazyNext;
+}
+
+void Highlighter::highlightBlocks( int first, int count )
+{
+    QTextBlock block = document()->findBlockByNumber( first );
+    for( int i=0; i<count && block.isValid(); ++i )
+    {
+        if( !isHighlighted( first+i ) )
+        {
+            rehighlightBlock( block );
+            m_lazyDone.insert( first+i );
+        }
+        block = block.next();
+}   }
+
+void Highlighter::highlightNext()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    highlightBlocks( m_firstVisible, m_visibleCount ); // Scrolled to blocks not done yet
+
+    QTextBlock block = document()->findBlockByNumber( m_lazyNext );
+    while( timer.elapsed() < 10 ) // Don't block UI more than 10 ms
+    {
+        if( !block.isValid() ) // Document end, continue from start
+        {
+            if( m_lazyWrapped || m_lazyStart == 0 ) { m_lazyTimer.stop(); return; }
+            m_lazyWrapped = true;
+            m_lazyNext = 0;
+            block = document()->firstBlock();
+        }
+        if( m_lazyWrapped && m_lazyNext >= m_lazyStart ) { m_lazyTimer.stop(); return; }
+
+        if( !m_lazyDone.contains( m_lazyNext ) )
+            rehighlightBlock( block ); // Also rehighlights next blocks if this block state changed
+        block = block.next();
+        m_lazyNext++;
+}   }
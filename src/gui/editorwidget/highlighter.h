@@ -8,6 +8,9 @@
 
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
+#include <QRegularExpression>
+#include <QTimer>
+#include <QSet>
 
 class QTextDocument;
 
@@ -26,17 +29,27 @@ class Highlighter : public QSyntaxHighlighter
         void setMembers( QStringList patterns );
         void setExtraTypes( QStringList types );
 
+        void setVisibleBlocks( int first, int count );
+
     protected:
         void highlightBlock( const QString &text );
 
+    private slots:
+        void highlightNext();
+
     private:
         struct HighlightRule
         {
-            QRegExp pattern;
+            QRegularExpression pattern;
             QTextCharFormat format;
         };
         void addRule( QTextCharFormat, QString );
-        void processRule( HighlightRule rule, QString lcText );
+        void addWords( QVector<HighlightRule>* rules, QTextCharFormat format, QStringList words );
+        inline void processRule( const HighlightRule &rule, const QString &text );
+
+        void rehighlightLazy();
+        void highlightBlocks( int first, int count );
+        bool isHighlighted( int block );
 
         bool m_multiline;
         
@@ -45,9 +58,18 @@ class Highlighter : public QSyntaxHighlighter
         QVector<HighlightRule> m_memberRules;
         QVector<HighlightRule> m_extraRules;
 
-        QRegExp m_multiStart;
-        QRegExp m_multiEnd;
+        QRegularExpression m_multiStart;
+        QRegularExpression m_multiEnd;
         QTextCharFormat m_multiFormat;
+
+        // Lazy rehighlight: visible blocks first, the rest in idle time
+        QTimer m_lazyTimer;
+        int  m_lazyStart;   // First block processed (visible when started)
+        int  m_lazyNext;    // Next block to process
+        bool m_lazyWrapped; // Reached document end, now processing from start
+        int  m_firstVisible;
+        int  m_visibleCount;
+        QSet<int> m_lazyDone; // Visible blocks done out of order
 };
 
 #endif
@@ -3,7 +3,17 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QPlainTextEdit>
+#include <QScrollBar>
+#include <QBoxLayout>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QFileDialog>
+#include <QTextStream>
+
 #include "mcumonitor.h"
+#include "scriptbase.h"
+#include "circuit.h"
 #include "simulator.h"
 #include "e_mcu.h"
 #include "cpubase.h"
@@ -23,12 +33,14 @@ MCUMonitor::MCUMonitor( QWidget* parent, eMcu* mcu )
     m_processor = mcu;
 
     m_jumpToAddress = false;
+    m_ramVersion = 0;
 
     m_statusReg    = nullptr;
     m_ramTable     = nullptr;
     m_ramMonitor   = nullptr;
     m_flashMonitor = nullptr;
     m_romMonitor   = nullptr;
+    m_profiler     = nullptr;
 
     createStatusPC();
 
@@ -76,6 +88,8 @@ MCUMonitor::MCUMonitor( QWidget* parent, eMcu* mcu )
         tabWidget->addTab( m_romMonitor, "EEPROM");
         connect( m_romMonitor,   SIGNAL(dataChanged(int, int)), this, SLOT(eepromDataChanged(int, int)) );
     }
+    if( m_processor->scripts()->size() ) createProfiler();
+
     connect( tabWidget, SIGNAL(currentChanged(int)), this, SLOT(tabChanged(int)) );
 }
 
@@ -113,6 +127,8 @@ void MCUMonitor::updateStep()
 {
     int pc = m_processor->cpu()->getPC();
 
+    if( m_processor->ramSize() ) m_processor->updateSnapshot(); // Read RAM without calling watchers
+
     if( m_statusReg )
     {
         int status = *m_statusReg; //m_processor->cpu->getStatus();
@@ -140,8 +156,17 @@ void MCUMonitor::updateStep()
     }
     if( m_ramMonitor && m_ramMonitor->isVisible() ) // RAM MemTable visible
     {
-        for( uint32_t i=0; i<m_processor->ramSize(); ++i )
-            m_ramMonitor->setValue( i, m_processor->getRamValue(i) );
+        uint32_t ramSize  = m_processor->ramSize();
+        uint32_t pageSize = m_processor->snapshotPageSize();
+        for( uint32_t page=0; page<ramSize; page+=pageSize ) // Only update pages changed since last update
+        {
+            if( !m_processor->pageChanged( page, m_ramVersion ) ) continue;
+
+            uint32_t end = page+pageSize;
+            if( end > ramSize ) end = ramSize;
+            for( uint32_t i=page; i<end; ++i ) m_ramMonitor->setValue( i, m_processor->snapshotValue(i) );
+        }
+        m_ramVersion = m_processor->snapshotVersion();
 
         if( Simulator::self()->simState() == SIM_RUNNING )
             m_ramMonitor->setAddrSelected( m_ramTable->getCurrentAddr(), m_jumpToAddress );
@@ -159,6 +184,7 @@ void MCUMonitor::updateStep()
          || Simulator::self()->simState() == SIM_PAUSED )
             m_flashMonitor->setAddrSelected( pc, m_jumpToAddress );
     }
+    if( m_profiler && m_profiler->isVisible() ) updateProfile();
 }
 
 void MCUMonitor::updateRamTable()
@@ -166,6 +192,88 @@ void MCUMonitor::updateRamTable()
     if( m_ramTable ) m_ramTable->updateItems();
 }
 
+void MCUMonitor::createProfiler()
+{
+    m_profiler = new QWidget( tabWidget );
+    QVBoxLayout* layout = new QVBoxLayout( m_profiler );
+
+    QHBoxLayout* buttons = new QHBoxLayout();
+    m_profCheck = new QCheckBox( tr("Enable"), m_profiler );
+    QPushButton* resetButton = new QPushButton( tr("Reset"), m_profiler );
+    QPushButton* saveButton  = new QPushButton( tr("Save Stacks"), m_profiler );
+    buttons->addWidget( m_profCheck );
+    buttons->addStretch();
+    buttons->addWidget( resetButton );
+    buttons->addWidget( saveButton );
+    layout->addLayout( buttons );
+
+    m_profText = new QPlainTextEdit( m_profiler );
+    m_profText->setReadOnly( true );
+    m_profText->setLineWrapMode( QPlainTextEdit::NoWrap );
+    QFont font;
+    font.setFamily("Ubuntu Mono");
+    font.setPixelSize( round( 12.5*MainWindow::self()->fontScale() ) );
+    m_profText->setFont( font );
+    layout->addWidget( m_profText );
+
+    connect( m_profCheck, &QCheckBox::toggled,  this, &MCUMonitor::profileToggled );
+    connect( resetButton, &QPushButton::clicked, this, &MCUMonitor::resetProfile );
+    connect( saveButton,  &QPushButton::clicked, this, &MCUMonitor::saveProfile );
+
+    tabWidget->addTab( m_profiler, tr("Profile") );
+}
+
+void MCUMonitor::profileToggled( bool p )
+{
+    for( ScriptBase* script : *m_processor->scripts() ) script->setProfiling( p );
+}
+
+void MCUMonitor::resetProfile()
+{
+    bool running = Simulator::self()->simState() > SIM_PAUSED;
+    if( running ) Simulator::self()->pauseSim();
+
+    for( ScriptBase* script : *m_processor->scripts() ) script->resetProfile();
+    updateProfile();
+
+    if( running ) Simulator::self()->resumeSim();
+}
+
+void MCUMonitor::updateProfile() // Called when Simulation thread is stopped
+{
+    QString report;
+    for( ScriptBase* script : *m_processor->scripts() ) report += script->profileReport()+"\n";
+
+    int scroll = m_profText->verticalScrollBar()->value();
+    m_profText->setPlainText( report );
+    m_profText->verticalScrollBar()->setValue( scroll );
+}
+
+void MCUMonitor::saveProfile() // Folded stacks: flamegraph.pl, speedscope, inferno...
+{
+    QString fileName = QFileDialog::getSaveFileName( this, tr("Save Profile"), Circuit::self()->getFilePath(),
+                                                     tr("Folded stacks (*.folded);;All files (*.*)") );
+    if( fileName.isEmpty() ) return;
+
+    bool running = Simulator::self()->simState() > SIM_PAUSED;
+    if( running ) Simulator::self()->pauseSim();
+
+    QStringList lines;
+    for( ScriptBase* script : *m_processor->scripts() ) lines += script->foldedStacks();
+
+    if( running ) Simulator::self()->resumeSim();
+
+    QFile file( fileName );
+    if( !file.open( QFile::WriteOnly | QFile::Text ) )
+    {
+        qDebug() << "MCUMonitor::saveProfile Error: Cannot write file"<<fileName;
+        return;
+    }
+    QTextStream out( &file );
+    out << lines.join("\n") << "\n";
+    file.close();
+}
+
 void MCUMonitor::createStatusPC()
 {
     m_statusReg = m_processor->cpu()->getStatus();
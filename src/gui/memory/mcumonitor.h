@@ -15,6 +15,8 @@ class eMcu;
 class MemTable;
 class RamTable;
 class Watcher;
+class QPlainTextEdit;
+class QCheckBox;
 
 class MCUMonitor : public QDialog, private Ui::McuMonitor
 {
@@ -34,8 +36,14 @@ class MCUMonitor : public QDialog, private Ui::McuMonitor
         void on_byteButton_toggled( bool byte );
         void on_jumpButton_toggled( bool jump );
 
+        void profileToggled( bool p );
+        void resetProfile();
+        void saveProfile();
+
     private:
         void createStatusPC();
+        void createProfiler();
+        void updateProfile();
 
         eMcu* m_processor;
 
@@ -47,10 +55,16 @@ class MCUMonitor : public QDialog, private Ui::McuMonitor
         MemTable* m_flashMonitor;
         MemTable* m_romMonitor;
 
+        QWidget*        m_profiler;   // Script Profiler
+        QCheckBox*      m_profCheck;
+        QPlainTextEdit* m_profText;
+
         QTableWidget m_status;
         QTableWidget m_pc;
 
         bool m_jumpToAddress;
+
+        uint32_t m_ramVersion; // RAM snapshot version shown in m_ramMonitor
 };
 
 #endif
@@ -7,6 +7,7 @@
 #include <QMenu>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QInputDialog>
 #include <QTextStream>
 #include <QDebug>
 
@@ -30,6 +31,7 @@ RamTable::RamTable( QWidget* parent, eMcu* processor ,bool cpuMonitor )
     m_debugger  = NULL;
     m_numRegs   = 60;
     m_loadingVars = false;
+    m_ramVersion = 0;
 
     float scale = MainWindow::self()->fontScale();
     int row_heigh = round( 22*scale );
@@ -156,9 +158,71 @@ void RamTable::slotContextMenu( const QPoint& point )
     QAction *saveVarSet = menu.addAction( QIcon(":/save.png"),tr("Save VarSet") );
     connect( saveVarSet, SIGNAL(triggered()), this, SLOT(saveVarSet()), Qt::UniqueConnection );
 
+    if( m_processor && !m_cpuMonitor )
+    {
+        menu.addSeparator();
+
+        QAction *watchWrites = menu.addAction( QIcon(":/breakpoint.png"),tr("Break on Write") );
+        connect( watchWrites, SIGNAL(triggered()), this, SLOT(watchWrites()), Qt::UniqueConnection );
+
+        QAction *watchCond = menu.addAction( QIcon(":/breakpoint.png"),tr("Break on Condition...") );
+        connect( watchCond, SIGNAL(triggered()), this, SLOT(watchCondition()), Qt::UniqueConnection );
+
+        QAction *remWatch = menu.addAction( QIcon(":/nobreakpoint.png"),tr("Remove Watchpoint") );
+        connect( remWatch, SIGNAL(triggered()), this, SLOT(remWatch()), Qt::UniqueConnection );
+
+        QAction *clearWatch = menu.addAction( QIcon(":/remove.svg"),tr("Clear Watchpoints") );
+        connect( clearWatch, SIGNAL(triggered()), this, SLOT(clearWatches()), Qt::UniqueConnection );
+    }
+
     menu.exec( mapToGlobal(point) );
 }
 
+int RamTable::watchAddress()
+{
+    int row = table->currentRow();
+    if( row < 0 ) return -1;
+    QTableWidgetItem* item = table->item( row, 0 );
+    if( !item ) return -1;
+
+    bool ok = false;
+    uint addr = item->text().toUInt( &ok, 16 );
+    if( !ok || addr >= m_processor->ramSize() ) return -1;
+    return m_processor->getMapperAddr( addr );
+}
+
+void RamTable::watchWrites()
+{
+    int addr = watchAddress();
+    if( addr >= 0 ) m_processor->setWatch( addr, "" );
+}
+
+void RamTable::watchCondition()
+{
+    int addr = watchAddress();
+    if( addr < 0 ) return;
+
+    bool ok = false;
+    QString cond = QInputDialog::getText( this, tr("Watchpoint"),
+                   tr("Break when written value (ex: == 0x10, > 5, & 4, changed):"),
+                   QLineEdit::Normal, "changed", &ok );
+    if( !ok ) return;
+
+    if( !m_processor->setWatch( addr, cond ) )
+        QMessageBox::warning( this, tr("Watchpoint"), tr("Invalid condition: ")+cond );
+}
+
+void RamTable::remWatch()
+{
+    int addr = watchAddress();
+    if( addr >= 0 ) m_processor->remWatch( addr );
+}
+
+void RamTable::clearWatches()
+{
+    m_processor->clearWatches();
+}
+
 void RamTable::clearSelected()
 {
     for( QTableWidgetItem* item : table->selectedItems() ) item->setData( 0, "");
@@ -313,6 +377,7 @@ void RamTable::addToWatch( QTableWidgetItem* it )
     table->setCurrentCell( _row, 1 );
 
     QString name = it->text().remove(" ").remove("\t").remove("*");//.toLower();
+    m_ramVersion = 0; // Refresh all values at next update
 
     if( name.isEmpty() )
     {
@@ -370,7 +435,7 @@ void RamTable::addToWatch( QTableWidgetItem* it )
                 if( varName.contains( name ) ) table->item( _row+i, 1 )->setText( varName );
 }   }   }   }
 
-void RamTable::updateValues()
+void RamTable::updateValues() // Values are read from RAM snapshot: no side effects
 {
     if( !m_processor ) return;
 
@@ -399,7 +464,11 @@ void RamTable::updateValues()
             int addr = name.toInt(&ok, 10);
             if( !ok && name.startsWith("0x") ) addr = name.toInt(&ok, 16);
 
-            if( ok ) value = m_processor->getRamValue( addr ); // Address
+            if( ok )                                           // Address
+            {
+                if( !m_processor->pageChanged( addr, m_ramVersion ) ) continue;
+                value = m_processor->snapshotValue( addr );
+            }
             else                                               // Var or Reg name
             {
                 QByteArray ba;
@@ -410,13 +479,19 @@ void RamTable::updateValues()
                 else                               address = m_processor->getRegAddress( name );
                 if( address < 0 ) return;
 
+                int bytes = 1;
+                if     ( type.contains( "32" ) ) bytes = 4;
+                else if( type.contains( "16" ) ) bytes = 2;
+                if( !m_processor->pageChanged( address, m_ramVersion )           // Value didn't change
+                 && !m_processor->pageChanged( address+bytes-1, m_ramVersion ) ) continue;
+
                 if( type ==  "string" )
                 {
                     QString strVal = "";
                     for( int i=address; i<=address+value; i++ )
                     {
                         QString str = "";
-                        const QChar cha = m_processor->getRamValue( i );
+                        const QChar cha = m_processor->snapshotValue( i );
                         str.setRawData( &cha, 1 );
                         strVal += str; //QByteArray::fromHex( getRamValue( i ) );
                     }
@@ -426,21 +501,21 @@ void RamTable::updateValues()
                     if( type.contains( "32" ) )    // 4 bytes
                     {
                         bits = 32;
-                        ba[0] = m_processor->getRamValue( address );
-                        ba[1] = m_processor->getRamValue( address+1 );
-                        ba[2] = m_processor->getRamValue( address+2 );
-                        ba[3] = m_processor->getRamValue( address+3 );
+                        ba[0] = m_processor->snapshotValue( address );
+                        ba[1] = m_processor->snapshotValue( address+1 );
+                        ba[2] = m_processor->snapshotValue( address+2 );
+                        ba[3] = m_processor->snapshotValue( address+3 );
                     }
                     else if( type.contains( "16" ) )  // 2 bytes
                     {
                         bits = 16;
-                        ba[0] = m_processor->getRamValue( address );
-                        ba[1] = m_processor->getRamValue( address+1 );
+                        ba[0] = m_processor->snapshotValue( address );
+                        ba[1] = m_processor->snapshotValue( address+1 );
                         ba[2] = 0;
                         ba[3] = 0;
                     }else{                             // 1 byte
                         bits = 8;
-                        ba[0] = m_processor->getRamValue( address );
+                        ba[0] = m_processor->snapshotValue( address );
                         ba[1] = 0;
                         ba[2] = 0;
                         ba[3] = 0;
@@ -495,5 +570,7 @@ void RamTable::updateValues()
             strVal = decStr+" 0x"+hexStr;
         }
         setValue( _row, strVal );
-}   }
+    }
+    if( !m_cpuMonitor ) m_ramVersion = m_processor->snapshotVersion();
+}
 
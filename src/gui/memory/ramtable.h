@@ -37,6 +37,7 @@ class RamTable : public QWidget, private Ui::RamTable
         void loadVarSet( QStringList varSet );
         QStringList getVarSet();
         uint16_t getCurrentAddr();
+        int varAddress( QString name ) { return m_varsTable.contains( name ) ? m_varsTable.value( name ) : -1; }
 
         void updateItems();
 
@@ -49,6 +50,10 @@ class RamTable : public QWidget, private Ui::RamTable
         void clearTable();
         void loadVarSet();
         void saveVarSet();
+        void watchWrites();
+        void watchCondition();
+        void remWatch();
+        void clearWatches();
 
     private slots:
         void addToWatch( QTableWidgetItem* );
@@ -60,6 +65,8 @@ class RamTable : public QWidget, private Ui::RamTable
         void setValue( int r, QString v );
         void setType( int r, QString t );
 
+        int watchAddress(); // Mapped address of current row, -1 if none
+
         eMcu* m_processor;
         BaseDebugger*  m_debugger;
 
@@ -78,5 +85,7 @@ class RamTable : public QWidget, private Ui::RamTable
 
         int m_numRegs;
         int m_currentRow;
+
+        uint32_t m_ramVersion; // RAM snapshot version of last update
 };
 #endif // RAMTABLE_H
@@ -47,13 +47,23 @@ void OutPanelText::updateStep()
 {
     if( m_textBuffer.isEmpty() ) return;
 
+    if( m_textBuffer.size() > maxChars() ) // Older text would be removed anyway
+    {
+        clear();
+        m_textBuffer = m_textBuffer.right( maxChars() );
+    }
     moveCursor( QTextCursor::End );
     insertPlainText( m_textBuffer );
     m_textBuffer.clear();
 
-    if( this->document()->characterCount() > 100000 )
-        setPlainText( this->toPlainText().right( 90000 ) );
-
+    int excess = document()->characterCount()-maxChars();
+    if( excess > maxChars()/10 ) // Remove oldest text without rebuilding the document
+    {
+        QTextCursor cursor( document() );
+        cursor.movePosition( QTextCursor::Start );
+        cursor.movePosition( QTextCursor::NextCharacter, QTextCursor::KeepAnchor, excess );
+        cursor.removeSelectedText();
+    }
     moveCursor( QTextCursor::End );
 }
 
@@ -26,6 +26,8 @@ class OutPanelText : public QPlainTextEdit, public Updatable
         void appendText( const QString text ) { m_textBuffer.append( text ); }
         void appendLine( const QString text );
 
+ static int maxChars() { return 90000; } // Max characters kept in panel
+
     private:
         QString m_textBuffer;
  
@@ -9,6 +9,7 @@
 #include "propdialog.h"
 #include "comproperty.h"
 #include "circuit.h"
+#include "component.h"
 
 PropVal::PropVal( PropDialog* parent, CompBase* comp, ComProperty* prop )
        : QWidget( parent )
@@ -55,4 +56,7 @@ void PropVal::saveChanges()
     }
     else m_propDialog->changed();
     m_propDialog->updtValues();
+
+    Component* comp = dynamic_cast<Component*>( m_component );
+    if( comp ) comp->update(); // Item may be cached while simulating
 }
@@ -0,0 +1,63 @@
+/***************************************************************************
+ *   Copyright (C) 2021 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef BYTERING_H
+#define BYTERING_H
+
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+#include <QByteArray>
+
+// Single-producer/single-consumer byte ring:
+// push() is called from Simulation thread, take() from GUI thread.
+// When full, new bytes are dropped and counted as lost.
+
+class ByteRing
+{
+    public:
+        ByteRing( uint32_t size=1<<16 ) // size must be a power of 2
+        {
+            m_data.resize( size );
+            m_mask = size-1;
+            m_head = 0;
+            m_tail = 0;
+            m_lost = 0;
+        }
+
+        inline void push( uint8_t byte ) // Producer
+        {
+            uint32_t head = m_head.load( std::memory_order_relaxed );
+            if( head-m_tail.load( std::memory_order_acquire ) > m_mask ) { m_lost++; return; } // Full
+
+            m_data[head & m_mask] = byte;
+            m_head.store( head+1, std::memory_order_release );
+        }
+
+        QByteArray take() // Consumer: get all available bytes
+        {
+            uint32_t tail = m_tail.load( std::memory_order_relaxed );
+            uint32_t size = m_head.load( std::memory_order_acquire )-tail;
+
+            QByteArray bytes;
+            bytes.resize( size );
+            for( uint32_t i=0; i<size; ++i ) bytes[i] = (char)m_data[(tail+i) & m_mask];
+
+            m_tail.store( tail+size, std::memory_order_release );
+            return bytes;
+        }
+
+        uint64_t takeLost() { return m_lost.exchange( 0 ); } // Consumer: get & reset lost bytes
+
+    private:
+        std::vector<uint8_t> m_data;
+        uint32_t m_mask;
+
+        std::atomic<uint32_t> m_head; // Written only by producer
+        std::atomic<uint32_t> m_tail; // Written only by consumer
+        std::atomic<uint64_t> m_lost;
+};
+
+#endif
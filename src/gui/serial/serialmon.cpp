@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QFileDialog>
+
 #include "serialmon.h"
 #include "usartmodule.h"
 #include "simulator.h"
@@ -48,10 +50,8 @@ SerialMonitor::SerialMonitor( QWidget* parent, UsartModule* usart, bool send )
 
 void SerialMonitor::updateStep()
 {
-    if( isVisible() && !m_paused ){
-        m_uartInPanel.updateStep();
-        m_uartOutPanel.updateStep();
-    }
+    updatePanel( &m_uartInPanel,  &m_inRing,  &m_inCapture );
+    updatePanel( &m_uartOutPanel, &m_outRing, &m_outCapture );
 
     if( m_outBuffer.isEmpty() ) return;
 
@@ -68,6 +68,58 @@ void SerialMonitor::on_pauseButton_clicked()
     else           pauseButton->setText( tr("Pause") );
 }
 
+void SerialMonitor::updatePanel( OutPanelText* panel, ByteRing* ring, QFile* capture )
+{
+    QByteArray bytes = ring->take();
+    uint64_t lost = ring->takeLost();
+
+    if( capture->isOpen() && !bytes.isEmpty() ) capture->write( bytes );
+
+    if( !isVisible() || m_paused ) return;
+
+    if( lost ) panel->appendText( "\n["+QString::number( lost )+" "+tr("bytes lost")+"]\n" );
+
+    if( !bytes.isEmpty() )
+    {
+        int charsPerByte = (m_printMode == 0) ? 1 : (m_printMode == 4) ? 9 : 4;
+        int maxBytes = OutPanelText::maxChars()/charsPerByte; // Only format what can be shown
+        int start = bytes.size()-maxBytes;
+        if( start < 0 ) start = 0;
+
+        QString text;
+        text.reserve( (bytes.size()-start)*charsPerByte );
+        for( int i=start; i<bytes.size(); ++i ) text.append( valToString( (uint8_t)bytes.at(i) ) );
+        panel->appendText( text );
+    }
+    panel->updateStep();
+}
+
+void SerialMonitor::on_captureButton_clicked()
+{
+    stopCapture();
+    if( !captureButton->isChecked() ) return;
+
+    QString fileName = QFileDialog::getSaveFileName( this, tr("Capture raw data"), "", "" );
+    if( fileName.isEmpty() ) { captureButton->setChecked( false ); return; }
+
+    fileName = getFileDir( fileName )+getBareName( fileName );
+    m_inCapture.setFileName( fileName+"_in.bin" );
+    m_outCapture.setFileName( fileName+"_out.bin" );
+
+    if( !m_inCapture.open( QIODevice::WriteOnly )
+     || !m_outCapture.open( QIODevice::WriteOnly ) )
+    {
+        stopCapture();
+        captureButton->setChecked( false );
+        MessageBoxNB( "SerialMonitor::on_captureButton_clicked", tr("Cannot write file:")+"\n"+fileName );
+}   }
+
+void SerialMonitor::stopCapture()
+{
+    if( m_inCapture.isOpen() )  m_inCapture.close();
+    if( m_outCapture.isOpen() ) m_outCapture.close();
+}
+
 void SerialMonitor::on_text_returnPressed()
 {
     if( m_paused ) return;
@@ -87,16 +139,14 @@ void SerialMonitor::on_printBox_currentIndexChanged( int index )
     m_printMode = index;
 }
 
-void SerialMonitor::printIn( int value ) // Receive one byte on Uart
+void SerialMonitor::printIn( int value ) // Receive one byte on Uart (Simulation thread)
 {
-    if( m_paused ) return;
-    m_uartInPanel.appendText( valToString( value ) );
+    m_inRing.push( value & 0xFF );
 }
 
-void SerialMonitor::printOut( int value ) // Send value to OutPanelText
+void SerialMonitor::printOut( int value ) // Send value to OutPanelText (Simulation thread)
 {
-    if( m_paused ) return;
-    m_uartOutPanel.appendText( valToString( value ) );
+    m_outRing.push( value & 0xFF );
 }
 
 QString SerialMonitor::valToString( int val )
@@ -128,5 +178,7 @@ void SerialMonitor::activateSend()
 void SerialMonitor::closeEvent( QCloseEvent* event )
 {
     event->accept();
+    stopCapture();
+    captureButton->setChecked( false );
     m_usart->monitorClosed();
 }
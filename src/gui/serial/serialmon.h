@@ -7,10 +7,12 @@
 #define SERIALMON_H
 
 #include <QDialog>
+#include <QFile>
 
 #include "ui_serialmon.h"
 #include "outpaneltext.h"
 #include "updatable.h"
+#include "bytering.h"
 
 class UsartModule;
 
@@ -34,6 +36,7 @@ class SerialMonitor : public QDialog, private Ui::SerialMonitor, public Updatabl
         void on_printBox_currentIndexChanged( int index );
         void on_addCrButton_clicked() { m_addCR = addCrButton->isChecked(); }
         void on_pauseButton_clicked();
+        void on_captureButton_clicked();
         void on_clearIn_clicked() { m_uartInPanel.clear(); }
         void on_clearOut_clicked() { m_uartOutPanel.clear(); }
 
@@ -42,6 +45,8 @@ class SerialMonitor : public QDialog, private Ui::SerialMonitor, public Updatabl
 
     private:
         QString valToString( int val );
+        void updatePanel( OutPanelText* panel, ByteRing* ring, QFile* capture );
+        void stopCapture();
 
         OutPanelText m_uartInPanel;
         OutPanelText m_uartOutPanel;
@@ -53,6 +58,12 @@ class SerialMonitor : public QDialog, private Ui::SerialMonitor, public Updatabl
         bool m_paused;
 
         QByteArray m_outBuffer;
+
+        ByteRing m_inRing;  // Filled from Simulation thread
+        ByteRing m_outRing; // Filled from Simulation thread
+
+        QFile m_inCapture;  // Raw capture files
+        QFile m_outCapture;
 };
 
 #endif
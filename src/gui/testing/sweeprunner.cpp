@@ -0,0 +1,492 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QCoreApplication>
+#include <QProcess>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+#include <QDir>
+#include <QDebug>
+#include <random>
+
+#include "sweeprunner.h"
+#include "circuitwidget.h"
+#include "simulator.h"
+#include "circuit.h"
+#include "component.h"
+#include "testunit.h"
+#include "meter.h"
+#include "probe.h"
+#include "e-element.h"
+#include "utils.h"
+
+class SweepEnd : public eElement // Pauses Simulation exactly at sweep end time
+{
+    public:
+        SweepEnd() : eElement("SweepEnd"){;}
+
+        virtual void runEvent() override { Simulator::self()->pauseSim(); }
+};
+
+bool SweepRunner::m_running = false;
+
+QString SweepRunner::m_circFile;
+QString SweepRunner::m_outFile;
+double  SweepRunner::m_simTime = 0;
+double  SweepRunner::m_speed   = 0;
+double  SweepRunner::m_timeout = 0;
+int     SweepRunner::m_runs    = 1;
+int     SweepRunner::m_maxJobs = 1;
+uint    SweepRunner::m_seed    = 1;
+
+QList<SweepRunner::param_t> SweepRunner::m_params;
+QVector<SweepRunner::job_t> SweepRunner::m_jobs;
+QStringList SweepRunner::m_resNames;
+QStringList SweepRunner::m_measures;
+QHash<QProcess*, int> SweepRunner::m_processes;
+int SweepRunner::m_nextJob  = 0;
+int SweepRunner::m_doneJobs = 0;
+
+uint64_t SweepRunner::m_endTime = 0;
+
+// Sweep file, one entry per line, # for comments:
+//   circuit: amplifier.sim1          (relative to sweep file)
+//   output:  amplifier.csv           (default: sweep file with .csv)
+//   time:    10 m                    (simulated seconds, optional multiplier)
+//   runs:    100                     (runs per variant if any random param)
+//   jobs:    4                       (parallel workers, default: ideal thread count)
+//   seed:    1
+//   speed:   0                       (simulated s per real s, 0 = Circuit speed)
+//   timeout: 60                      (real seconds per job, 0 = no timeout)
+//   param:   R1.Resistance range 1000 2000 5     (start stop points)
+//   param:   V1.Voltage list 3.3 5
+//   param:   R2.Resistance tol 10000 5           (nominal, +-percent uniform)
+//   param:   C1.Capacitance gauss 1e-6 5e-8      (mean, sigma)
+//   measure: Voltmeter-1 Probe-3                 (default: all measurements)
+// Numeric values are in base units (Ohm, V, F, s...).
+
+void SweepRunner::doSweep( QString sweepFile )
+{
+    if( m_running ) { qDebug() << "SweepRunner::doSweep Error: Sweep already running"; return; }
+
+    if( !readSweepFile( sweepFile ) ) { QCoreApplication::exit( 2 ); return; }
+
+    createJobs();
+    if( m_jobs.isEmpty() ) { qDebug() << "SweepRunner::doSweep Error: No jobs to run"; QCoreApplication::exit( 2 ); return; }
+
+    qDebug() << "Sweep:" << m_jobs.size() << "jobs," << m_maxJobs << "in parallel";
+
+    m_nextJob  = 0;
+    m_doneJobs = 0;
+    m_running  = true;
+    startJobs();
+}
+
+bool SweepRunner::readSweepFile( QString sweepFile )
+{
+    QFile file( sweepFile );
+    if( !file.open( QFile::ReadOnly | QFile::Text ) )
+    {
+        qDebug() << "SweepRunner::readSweepFile Error: Could not open:" << endl << sweepFile;
+        return false;
+    }
+    QDir dir = QFileInfo( sweepFile ).absoluteDir();
+
+    m_circFile.clear();
+    m_outFile = dir.absoluteFilePath( QFileInfo( sweepFile ).completeBaseName()+".csv" );
+    m_simTime = 0;
+    m_speed   = 0;
+    m_timeout = 0;
+    m_runs    = 1;
+    m_maxJobs = QThread::idealThreadCount();
+    m_seed    = 1;
+    m_params.clear();
+    m_measures.clear();
+
+    QTextStream in( &file );
+    int lineNum = 0;
+    while( !in.atEnd() )
+    {
+        QString line = in.readLine();
+        lineNum++;
+        line = line.left( line.indexOf("#") ).simplified(); // indexOf = -1 if no comment
+        if( line.isEmpty() ) continue;
+
+        int colon = line.indexOf(":");
+        QString key = line.left( colon ).trimmed().toLower();
+        QStringList args = line.mid( colon+1 ).split(" ");
+        args.removeAll("");
+        if( colon < 0 || args.isEmpty() )
+        {
+            qDebug() << "SweepRunner::readSweepFile Error: Bad line" << lineNum << line;
+            return false;
+        }
+        QString arg = args.first();
+
+        if     ( key == "circuit" ) m_circFile = dir.absoluteFilePath( args.join(" ") );
+        else if( key == "output"  ) m_outFile  = dir.absoluteFilePath( args.join(" ") );
+        else if( key == "runs"    ) m_runs     = arg.toInt();
+        else if( key == "jobs"    ) m_maxJobs  = arg.toInt();
+        else if( key == "seed"    ) m_seed     = arg.toUInt();
+        else if( key == "speed"   ) m_speed    = arg.toDouble();
+        else if( key == "timeout" ) m_timeout  = arg.toDouble();
+        else if( key == "time"    )
+        {
+            m_simTime = arg.toDouble();
+            if( args.size() > 1 ) m_simTime *= getMultiplier( args.at(1) );
+        }
+        else if( key == "measure" ) m_measures.append( args );
+        else if( key == "param" )
+        {
+            int dot = arg.lastIndexOf(".");
+            if( dot < 1 || args.size() < 3 )
+            {
+                qDebug() << "SweepRunner::readSweepFile Error: Bad param in line" << lineNum << line;
+                return false;
+            }
+            param_t param;
+            param.comp = arg.left( dot );
+            param.prop = arg.mid( dot+1 );
+            param.nominal   = 0;
+            param.deviation = 0;
+
+            QString type = args.at(1).toLower();
+            if( type == "range" && args.size() > 4 )
+            {
+                param.type = paramRange;
+                double start = args.at(2).toDouble();
+                double stop  = args.at(3).toDouble();
+                int points   = args.at(4).toInt();
+                if( points < 1 ) points = 1;
+                for( int i=0; i<points; ++i )
+                {
+                    double v = (points == 1) ? start : start+(stop-start)*i/(points-1);
+                    param.values.append( QString::number( v, 'g', 12 ) );
+                }
+            }
+            else if( type == "list" )
+            {
+                param.type = paramList;
+                param.values = args.mid( 2 );
+            }
+            else if( (type == "tol" || type == "gauss") && args.size() > 3 )
+            {
+                param.type = (type == "tol") ? paramTol : paramGauss;
+                param.nominal   = args.at(2).toDouble();
+                param.deviation = args.at(3).toDouble();
+            }else{
+                qDebug() << "SweepRunner::readSweepFile Error: Bad param in line" << lineNum << line;
+                return false;
+            }
+            m_params.append( param );
+        }else{
+            qDebug() << "SweepRunner::readSweepFile Error: Unknown key in line" << lineNum << line;
+            return false;
+    }   }
+    file.close();
+
+    if( m_circFile.isEmpty() || !QFileInfo::exists( m_circFile ) )
+    {
+        qDebug() << "SweepRunner::readSweepFile Error: Circuit doesn't exist:" << endl << m_circFile;
+        return false;
+    }
+    if( m_simTime <= 0 )
+    {
+        qDebug() << "SweepRunner::readSweepFile Error: Simulation time not set";
+        return false;
+    }
+    if( m_runs < 1 )    m_runs = 1;
+    if( m_maxJobs < 1 ) m_maxJobs = 1;
+    m_resNames = m_measures; // Columns in listed order, or as found if empty
+    return true;
+}
+
+void SweepRunner::createJobs() // Cartesian product of ranges and lists, random params in each run
+{
+    m_jobs.clear();
+
+    int variants = 1;
+    bool random = false;
+    for( const param_t& param : m_params )
+    {
+        if( param.type == paramRange || param.type == paramList ) variants *= param.values.size();
+        else random = true;
+    }
+    int runs = random ? m_runs : 1;
+
+    std::mt19937 gen( m_seed );
+
+    for( int v=0; v<variants; ++v )
+    {
+        for( int r=0; r<runs; ++r )
+        {
+            job_t job;
+            job.variant = v;
+            job.run     = r;
+
+            int index = v;
+            for( const param_t& param : m_params )
+            {
+                double value = 0;
+                switch( param.type )
+                {
+                    case paramRange:
+                    case paramList:{
+                        int size = param.values.size();
+                        job.values.append( param.values.at( index%size ) );
+                        index /= size;
+                    } continue;
+                    case paramTol:{
+                        double tol = param.nominal*param.deviation/100;
+                        std::uniform_real_distribution<double> dist( param.nominal-tol, param.nominal+tol );
+                        value = dist( gen );
+                    } break;
+                    case paramGauss:{
+                        std::normal_distribution<double> dist( param.nominal, param.deviation );
+                        value = dist( gen );
+                    } break;
+                }
+                job.values.append( QString::number( value, 'g', 12 ) );
+            }
+            m_jobs.append( job );
+}   }   }
+
+void SweepRunner::startJobs()
+{
+    while( m_processes.size() < m_maxJobs && m_nextJob < m_jobs.size() )
+    {
+        int index = m_nextJob++;
+        const job_t& job = m_jobs.at( index );
+
+        QStringList args = { "-platform", "offscreen", "-sweepjob", m_circFile
+                           , QString::number( m_simTime, 'g', 12 ), QString::number( m_speed, 'g', 12 ) };
+
+        for( int i=0; i<m_params.size(); ++i )
+            args.append( m_params.at(i).comp+"."+m_params.at(i).prop+"="+job.values.at(i) );
+
+        QProcess* process = new QProcess();
+        m_processes[process] = index;
+
+        QObject::connect( process, QOverload<int, QProcess::ExitStatus>::of( &QProcess::finished )
+                        , [process]( int exitCode, QProcess::ExitStatus ){ jobFinished( process, exitCode ); } );
+
+        process->start( QCoreApplication::applicationFilePath(), args );
+
+        if( m_timeout > 0 )
+            QTimer::singleShot( int(m_timeout*1000), process, [process](){ process->kill(); } );
+}   }
+
+void SweepRunner::jobFinished( QProcess* process, int exitCode )
+{
+    int index = m_processes.take( process );
+    job_t& job = m_jobs[index];
+
+    QString output = QString::fromLocal8Bit( process->readAllStandardOutput() );
+    for( QString line : output.split("\n") )
+    {
+        QStringList fields = line.trimmed().split("\t");
+        if( fields.size() < 3 || fields.first() != "SWEEP_RESULT" ) continue;
+
+        QString name = fields.at(1);
+        if( !m_measures.isEmpty() && !m_measures.contains( name ) ) continue;
+
+        job.results[name] = fields.at(2);
+        if( !m_resNames.contains( name ) ) m_resNames.append( name );
+    }
+    if     ( process->exitStatus() == QProcess::CrashExit ) job.status = "killed";
+    else if( exitCode != 0 ) job.status = "error "+QString::number( exitCode );
+    else                     job.status = "ok";
+
+    if( job.status != "ok" )
+    {
+        qDebug() << "SweepRunner: Job" << index << "failed:" << job.status;
+        QStringList errors = QString::fromLocal8Bit( process->readAllStandardError() ).split("\n");
+        errors.removeAll("");
+        for( QString error : errors.mid( errors.size()-5 ) ) qDebug() << "   " << error;
+    }
+    process->deleteLater();
+
+    m_doneJobs++;
+    if( m_doneJobs%10 == 0 || m_doneJobs == m_jobs.size() )
+        qDebug() << "Sweep:" << m_doneJobs << "/" << m_jobs.size() << "jobs done";
+
+    if( m_doneJobs < m_jobs.size() ) { startJobs(); return; }
+
+    bool ok = writeResults();
+    m_running = false;
+    QCoreApplication::exit( ok ? 0 : 1 );
+}
+
+static QString csvField( QString field )
+{
+    if( field.contains(",") || field.contains("\"") || field.contains("\n") )
+        field = "\""+field.replace("\"", "\"\"")+"\"";
+    return field;
+}
+
+bool SweepRunner::writeResults() // Returns false if not written or some job failed
+{
+    QFile file( m_outFile );
+    if( !file.open( QFile::WriteOnly | QFile::Text | QFile::Truncate ) )
+    {
+        qDebug() << "SweepRunner::writeResults Error: Could not write:" << endl << m_outFile;
+        return false;
+    }
+    QTextStream out( &file );
+
+    QStringList header = { "variant", "run" };
+    for( const param_t& param : m_params ) header.append( csvField( param.comp+"."+param.prop ) );
+    header.append("status");
+    for( QString name : m_resNames ) header.append( csvField( name ) );
+    out << header.join(",") << "\n";
+
+    int failed = 0;
+    for( const job_t& job : m_jobs )
+    {
+        QStringList row = { QString::number( job.variant ), QString::number( job.run ) };
+        for( QString value : job.values ) row.append( csvField( value ) );
+        row.append( job.status );
+        for( QString name : m_resNames ) row.append( csvField( job.results.value( name ) ) );
+        out << row.join(",") << "\n";
+
+        if( job.status != "ok" ) failed++;
+    }
+    file.close();
+
+    if( failed ) qDebug() << "Sweep:" << failed << "jobs failed";
+    qDebug() << "Sweep results saved to:" << endl << m_outFile;
+    return failed == 0;
+}
+
+//-----------------------------------------------------------------------------
+// Worker: -sweepjob <circuit> <time> <speed> [Comp.Prop=value ...]
+
+void SweepRunner::runJob( QStringList args )
+{
+    if( args.size() < 3 ) { qDebug() << "SweepRunner::runJob Error: Missing arguments"; QCoreApplication::exit( 2 ); return; }
+
+    QString circFile = args.takeFirst();
+    double  simTime  = args.takeFirst().toDouble();
+    double  speed    = args.takeFirst().toDouble();
+
+    Circuit::self()->loadCircuit( circFile );
+    if( Circuit::self()->compList()->isEmpty() )
+    {
+        qDebug() << "SweepRunner::runJob Error: Could not load Circuit:" << endl << circFile;
+        QCoreApplication::exit( 2 );
+        return;
+    }
+    for( QString assign : args )
+    {
+        if( setParam( assign ) ) continue;
+        QCoreApplication::exit( 2 );
+        return;
+    }
+    if( speed > 0 ) Simulator::self()->setPsPerSec( speed*1e12 );
+
+    m_endTime = simTime*1e12;
+    if( m_endTime < 1 ) m_endTime = 1;
+    m_running = true;
+
+    SweepEnd* sweepEnd = new SweepEnd(); // Lives until worker exits
+    CircuitWidget::self()->powerCircOn();
+    Simulator::self()->addEvent( m_endTime-Simulator::self()->circTime(), sweepEnd );
+    checkJob();
+}
+
+bool SweepRunner::setParam( QString assign ) // Comp.Prop=value
+{
+    int eq  = assign.indexOf("=");
+    int dot = assign.left( eq ).lastIndexOf(".");
+    if( eq < 0 || dot < 1 )
+    {
+        qDebug() << "SweepRunner::setParam Error: Bad parameter:" << assign;
+        return false;
+    }
+    QString compId = assign.left( dot );
+    QString prop   = assign.mid( dot+1, eq-dot-1 );
+    QString value  = assign.mid( eq+1 );
+
+    Component* comp = nullptr;
+    for( Component* c : *Circuit::self()->compList() )
+    {
+        if( c->idLabel() == compId || c->getUid() == compId ) { comp = c; break; }
+    }
+    if( !comp )
+    {
+        qDebug() << "SweepRunner::setParam Error: Component not found:" << compId;
+        return false;
+    }
+    bool ok;
+    double val = value.toDouble( &ok );
+    QStringList current = comp->getPropStr( prop ).split(" ");
+    if( ok && current.size() > 1 ) // Numeric property with unit: value is in base units
+    {
+        QString unit = current.last();
+        value = QString::number( val/getMultiplier( unit ), 'g', 12 )+" "+unit;
+    }
+    if( !comp->setPropStr( prop, value ) )
+    {
+        qDebug() << "SweepRunner::setParam Error: Property not found:" << compId << prop;
+        return false;
+    }
+    return true;
+}
+
+void SweepRunner::checkJob()
+{
+    Simulator* sim = Simulator::self();
+
+    if( !sim->isRunning() ) // Simulation stopped by error
+    {
+        qDebug() << "SweepRunner::checkJob Error: Simulation stopped at" << sim->circTime() << "ps";
+        m_running = false;
+        QCoreApplication::exit( 3 );
+        return;
+    }
+    if( !sim->isPaused() ) { QTimer::singleShot( 50, SweepRunner::checkJob ); return; } // Paused by SweepEnd
+
+    sim->waitCircuit();
+    collectResults();
+
+    m_running = false;
+    CircuitWidget::self()->powerCircOff();
+    QCoreApplication::exit( 0 );
+}
+
+void SweepRunner::collectResults() // Meters refresh in updateStep(): update now, next frame may not have run yet
+{
+    QTextStream out( stdout );
+
+    for( Component* comp : *Circuit::self()->compList() )
+    {
+        QString type = comp->itemType();
+        QString value;
+
+        if( type == "Voltimeter" || type == "Amperimeter" )
+        {
+            Meter* meter = static_cast<Meter*>( comp );
+            meter->updateStep();
+            value = QString::number( meter->dispValue(), 'g', 12 );
+        }
+        else if( type == "Probe" )
+        {
+            Probe* probe = static_cast<Probe*>( comp );
+            probe->updateStep();
+            value = QString::number( probe->voltIn(), 'g', 12 );
+        }
+        else if( type == "TestUnit" )
+        {
+            int result = static_cast<TestUnit*>( comp )->testResult();
+            value = (result < 0) ? "none" : (result ? "pass" : "fail");
+        }
+        else continue;
+
+        out << "SWEEP_RESULT\t" << comp->idLabel() << "\t" << value << "\n";
+    }
+    out.flush();
+}
@@ -0,0 +1,86 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef SWEEPRUNNER_H
+#define SWEEPRUNNER_H
+
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+
+class QProcess;
+
+// Runs a circuit many times with varied property values.
+// Coordinator: reads a sweep file, creates all variants and runs each one
+// in a headless worker process, results are written to a CSV table.
+// Coordinator exits when done: 0 = all jobs ok, 1 = some job failed, 2 = bad sweep file.
+// Worker: loads circuit, sets properties, simulates and prints measurements.
+
+class SweepRunner
+{
+    public:
+        static void doSweep( QString sweepFile );                  // Coordinator
+        static void runJob( QStringList args );                     // Worker
+
+        static bool isRunning() { return m_running; }
+
+    private:
+        enum paramType_t{
+            paramRange=0,
+            paramList,
+            paramTol,
+            paramGauss
+        };
+        struct param_t{
+            QString comp;
+            QString prop;
+            paramType_t type;
+            QStringList values;   // Range and List
+            double nominal;       // Tol: nominal, Gauss: mean
+            double deviation;     // Tol: percent, Gauss: sigma
+        };
+        struct job_t{
+            int variant;
+            int run;
+            QStringList values;   // One per param
+            QString status;
+            QHash<QString, QString> results;
+        };
+
+        static bool readSweepFile( QString sweepFile );
+        static void createJobs();
+        static void startJobs();
+        static void jobFinished( QProcess* process, int exitCode );
+        static bool writeResults();
+
+        static void checkJob();
+        static void collectResults();
+        static bool setParam( QString assign );
+
+        static bool m_running;
+
+        // Coordinator
+        static QString m_circFile;
+        static QString m_outFile;
+        static double  m_simTime;     // Seconds
+        static double  m_speed;       // 0 = Circuit speed
+        static double  m_timeout;     // Seconds per job, 0 = no timeout
+        static int     m_runs;
+        static int     m_maxJobs;
+        static uint    m_seed;
+
+        static QList<param_t> m_params;
+        static QVector<job_t> m_jobs;
+        static QStringList    m_resNames;  // Measurement columns
+        static QStringList    m_measures;  // Measurements to keep, empty = all
+        static QHash<QProcess*, int> m_processes;
+        static int m_nextJob;
+        static int m_doneJobs;
+
+        // Worker
+        static uint64_t m_endTime;    // Picoseconds
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include "mainwindow.h"
 #include "circuitwidget.h"
 #include "batchtest.h"
+#include "sweeprunner.h"
 
 void myMessageOutput( QtMsgType type, const QMessageLogContext &context, const QString &msg )
 {
@@ -71,15 +72,29 @@ int main( int argc, char *argv[] )
     app.installTranslator( &translator );
     app.setApplicationVersion( APP_VERSION );
 
+    QString arg = ( argc > 1 ) ? QString::fromStdString( argv[1] ) : "";
+
     MainWindow window;
     window.setLoc( locale );
-    window.show();
+    if( arg != "-sweepjob" && arg != "-sweep" ) window.show(); // Sweeps run headless
 
     if( argc > 1 )
     {
-        QString arg = QString::fromStdString( argv[1] );
-
-        if( arg == "-test" )
+        if( arg == "-sweepjob" )
+        {
+            QStringList args;
+            for( int i=2; i<argc; ++i ) args.append( QString::fromLocal8Bit( argv[i] ) );
+            QTimer::singleShot( 0, [args](){ SweepRunner::runJob( args ); } );
+        }
+        else if( arg == "-sweep" )
+        {
+            if( argc > 2 ){
+                arg = QString::fromStdString( argv[2] );
+                QTimer::singleShot( 300, [arg](){ SweepRunner::doSweep( arg ); } );
+            }
+            else{ qDebug() << "Usage: simulide [-platform offscreen] -sweep <sweep file>"; return 2; }
+        }
+        else if( arg == "-test" )
         {
             if( argc > 2 ){
                 arg = QString::fromStdString( argv[2] );
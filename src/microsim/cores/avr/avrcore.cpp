@@ -360,8 +360,8 @@ void AvrCore::runStep()
                 //default: ;//_avr_invalid_instruction(avr);
             }
             get_d5_q6( instruction );
-            if( instruction & 0x0200) SET_RAM( v+q, m_dataMem[d] );
-            else                      SET_RAM( d, GET_RAM(v+q) );
+            if( instruction & 0x0200) setRam( v+q, m_dataMem[d] );
+            else                      setRam( d, getRam(v+q) );
             cycle += 1; // 2 cycles, 3 for tinyavr
         }    break;
 
@@ -448,7 +448,7 @@ void AvrCore::runStep()
                             get_d5( instruction );
                             uint16_t x = m_progMem[new_pc];
                             new_pc += 1;
-                            m_dataMem[d] = GET_RAM(x);
+                            m_dataMem[d] = getRam(x);
                             cycle++; // 2 cycles
                         }    break;
                         case 0x9005:
@@ -497,7 +497,7 @@ void AvrCore::runStep()
                             uint16_t x = (m_dataMem[R_XH] << 8) | m_dataMem[R_XL];
                             cycle++; // 2 cycles( 1 for tinyavr, except with inc/dec 2)
                             if( op == 2) x--;
-                            uint8_t vd = GET_RAM(x);
+                            uint8_t vd = getRam(x);
                             if( op == 1) x++;
                             SET_REG16_HL( R_XL, x);
                             m_dataMem[d] = vd;
@@ -510,7 +510,7 @@ void AvrCore::runStep()
                             uint16_t x =( m_dataMem[R_XH] << 8) | m_dataMem[R_XL];
                             cycle++; // 2 cycles, except tinyavr
                             if( op == 2) x--;
-                            SET_RAM( x, vd );
+                            setRam( x, vd );
                             if( op == 1) x++;
                             SET_REG16_HL( R_XL, x);
                         }    break;
@@ -521,7 +521,7 @@ void AvrCore::runStep()
                             uint16_t y =( m_dataMem[R_YH] << 8) | m_dataMem[R_YL];
                             cycle++; // 2 cycles, except tinyavr
                             if( op == 2) y--;
-                            uint8_t vd = GET_RAM(y);
+                            uint8_t vd = getRam(y);
                             if( op == 1) y++;
                             SET_REG16_HL( R_YL, y);
                             m_dataMem[d] = vd;
@@ -533,7 +533,7 @@ void AvrCore::runStep()
                             uint16_t y =( m_dataMem[R_YH] << 8) | m_dataMem[R_YL];
                              cycle++;
                             if( op == 2) y--;
-                            SET_RAM( y, vd );
+                            setRam( y, vd );
                             if( op == 1) y++;
                             SET_REG16_HL( R_YL, y);
                         }    break;
@@ -542,7 +542,7 @@ void AvrCore::runStep()
                             uint16_t x = m_progMem[new_pc];
                             new_pc += 1;
                             cycle++;
-                            SET_RAM( x, vd );
+                            setRam( x, vd );
                         }    break;
                         case 0x9001:
                         case 0x9002: {    // LD -- Load Indirect from Data using Z -- 1001 000d dddd 00oo
@@ -551,7 +551,7 @@ void AvrCore::runStep()
                             uint16_t z =( m_dataMem[R_ZH] << 8) | m_dataMem[R_ZL];
                             cycle++;; // 2 cycles, except tinyavr
                             if( op == 2) z--;
-                            uint8_t vd = GET_RAM(z);
+                            uint8_t vd = getRam(z);
                             if( op == 1) z++;
                             SET_REG16_HL( R_ZL, z);
                             m_dataMem[d] = vd;
@@ -563,7 +563,7 @@ void AvrCore::runStep()
                             uint16_t z =( m_dataMem[R_ZH] << 8) | m_dataMem[R_ZL];
                              cycle++; // 2 cycles, except tinyavr
                             if( op == 2) z--;
-                            SET_RAM( z, vd );
+                            setRam( z, vd );
                             if( op == 1 ) z++;
                             SET_REG16_HL( R_ZL, z);
                         }    break;
@@ -681,13 +681,13 @@ void AvrCore::runStep()
                                 }    break;
                                 case 0x9800: {    // CBI -- Clear Bit in I/O Register -- 1001 1000 AAAA Abbb
                                     get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & ~mask;
-                                    SET_RAM( io, res );
+                                    uint8_t res = getRam( io ) & ~mask;
+                                    setRam( io, res );
                                     cycle++;
                                 }    break;
                                 case 0x9900: {    // SBIC -- Skip if Bit in I/O Register is Cleared -- 1001 1001 AAAA Abbb
                                     get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & mask;
+                                    uint8_t res = getRam( io ) & mask;
                                     if( !res)
                                     {
                                         if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
@@ -696,13 +696,13 @@ void AvrCore::runStep()
                                 }    break;
                                 case 0x9a00: {    // SBI -- Set Bit in I/O Register -- 1001 1010 AAAA Abbb
                                     get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) | mask;
-                                    SET_RAM( io, res );
+                                    uint8_t res = getRam( io ) | mask;
+                                    setRam( io, res );
                                     cycle++;
                                 }    break;
                                 case 0x9b00: {    // SBIS -- Skip if Bit in I/O Register is Set -- 1001 1011 AAAA Abbb
                                     get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & mask;
+                                    uint8_t res = getRam( io ) & mask;
                                     if( res )
                                     {
                                         if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
@@ -734,11 +734,11 @@ void AvrCore::runStep()
             switch( instruction & 0xf800) {
                 case 0xb800: {    // OUT A,Rr -- 1011 1AAd dddd AAAA
                     get_d5_a6( instruction );
-                    SET_RAM( A, m_dataMem[d] );
+                    setRam( A, m_dataMem[d] );
                 }    break;
                 case 0xb000: {    // IN Rd,A -- 1011 0AAd dddd AAAA
                     get_d5_a6( instruction );
-                    m_dataMem[d] = GET_RAM(A);
+                    m_dataMem[d] = getRam(A);
                 }    break;
                 default: ;//_avr_invalid_instruction(avr);
             }
@@ -14,7 +14,7 @@
 
 #include "mcucpu.h"
 
-class AvrCore : public McuCpu
+class AvrCore final : public McuCpu
 {
     public:
         AvrCore( eMcu* mcu );
@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "cpubase.h"
 
 CpuBase::CpuBase( eMcu* mcu )
@@ -22,3 +24,13 @@ void CpuBase::reset()
 {
     m_PC = 0;
 }
+
+void CpuBase::saveState( QDataStream& out )
+{
+    out << m_PC << m_RET_ADDR;
+}
+
+void CpuBase::loadState( QDataStream& in )
+{
+    in >> m_PC >> m_RET_ADDR;
+}
@@ -33,6 +33,9 @@ class CpuBase : public CoreBase
 
         virtual void exitSleep() {;}
 
+        virtual void saveState( QDataStream& out );  // Checkpoint: CPUs with more state should extend these
+        virtual void loadState( QDataStream& in );
+
     protected:
         eMcu* m_mcu;
 
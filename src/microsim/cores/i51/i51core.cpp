@@ -199,8 +199,8 @@ void I51Core::readOperand()
         }
     }
     else if( addrMode & aDIRE ){
-        if     ( addrMode & aORIG ) m_op0 = GET_RAM( m_pgmData );
-        else if( addrMode & aRELA ) m_op2 = GET_RAM( m_pgmData );
+        if     ( addrMode & aORIG ) m_op0 = getRam( m_pgmData );
+        else if( addrMode & aRELA ) m_op2 = getRam( m_pgmData );
         else                        m_opAddr = m_pgmData;
     }
     else if( addrMode & aRELA ){
@@ -218,10 +218,10 @@ void I51Core::readOperand()
 void I51Core::operRgx() { m_op0 = m_dataMem[ m_RxAddr ]; }        //
 void I51Core::operInd() { m_op0 = readInd( I_RX_VAL ); }          //
 void I51Core::operI08() { m_readOp.append( aIMME | aORIG ); }     // m_op0 = data
-void I51Core::operDir() { m_readOp.append( aDIRE | aORIG ); }     // m_op0 = GET_RAM( data );
+void I51Core::operDir() { m_readOp.append( aDIRE | aORIG ); }     // m_op0 = getRam( data );
 void I51Core::operACC() { m_op0 = ACC; }                          //
 void I51Core::opr2I08() { m_readOp.append( aIMME | aRELA ); }     // m_op2 = data;
-void I51Core::opr2Dir() { m_readOp.append( aDIRE | aRELA ); }     // m_op2 = GET_RAM( data );
+void I51Core::opr2Dir() { m_readOp.append( aDIRE | aRELA ); }     // m_op2 = getRam( data );
 
 void I51Core::addrRgx() { m_opAddr = m_RxAddr; }
 void I51Core::addrInd() { m_opAddr = checkAddr( I_RX_VAL );}      //
@@ -308,21 +308,21 @@ void I51Core::RET() { m_PC  = popStack8() << 8; m_PC |= popStack8(); }
 
 void I51Core::JBC()
 {
-    uint8_t v = GET_RAM( m_bitAddr );
+    uint8_t v = getRam( m_bitAddr );
     if( v & m_bitMask )
     {
-        SET_RAM( m_bitAddr, v & ~m_bitMask );
+        setRam( m_bitAddr, v & ~m_bitMask );
         m_PC += (int8_t)m_opAddr;
     }
 }
 
 void I51Core::JB()
 {
-    if( GET_RAM( m_bitAddr ) & m_bitMask ) m_PC += (int8_t)m_opAddr;
+    if( getRam( m_bitAddr ) & m_bitMask ) m_PC += (int8_t)m_opAddr;
 }
 
 void I51Core::JNB()
-{ if( !(GET_RAM( m_bitAddr ) & m_bitMask) ) m_PC += (int8_t)m_opAddr; }
+{ if( !(getRam( m_bitAddr ) & m_bitMask) ) m_PC += (int8_t)m_opAddr; }
 
 void I51Core::JC()  { if(  STATUS(Cy) ) m_PC += (int8_t)m_opAddr; }
 void I51Core::JNC() { if( !STATUS(Cy) ) m_PC += (int8_t)m_opAddr; }
@@ -332,14 +332,14 @@ void I51Core::JNZ() { if(  ACC        ) m_PC += (int8_t)m_opAddr; }
 void I51Core::MOVbc()
 {
     uint8_t carry = STATUS(Cy) >> Cy;
-    uint8_t     value = GET_RAM( m_bitAddr ) & ~m_bitMask; // Clear bit
-    if( carry ) value = GET_RAM( m_bitAddr ) | m_bitMask;  // Set bit if Carry
+    uint8_t     value = getRam( m_bitAddr ) & ~m_bitMask; // Clear bit
+    if( carry ) value = getRam( m_bitAddr ) | m_bitMask;  // Set bit if Carry
 
-    SET_RAM( m_bitAddr, value );
+    setRam( m_bitAddr, value );
 }
 void I51Core::MOVc()
 {
-    uint8_t value = (GET_RAM( m_bitAddr ) & m_bitMask) ? 1 : 0;
+    uint8_t value = (getRam( m_bitAddr ) & m_bitMask) ? 1 : 0;
     write_S_Bit( Cy, value );
 }
 
@@ -347,7 +347,7 @@ void I51Core::ORLc()
 {
     uint8_t carry = STATUS(Cy) >> Cy;
 
-    uint8_t value = GET_RAM( m_bitAddr ) & m_bitMask;
+    uint8_t value = getRam( m_bitAddr ) & m_bitMask;
     if( m_invert ) value = value ? 1 : carry;
     else           value = value ? carry : 1;
 
@@ -358,7 +358,7 @@ void I51Core::ANLc()
 {
     uint8_t carry = STATUS(Cy) >> Cy;
 
-    uint8_t value = GET_RAM( m_bitAddr ) & m_bitMask ;
+    uint8_t value = getRam( m_bitAddr ) & m_bitMask ;
     if( m_invert ) value = value ? 0 : carry;
     else           value = value ? carry : 0;
 
@@ -369,9 +369,9 @@ void I51Core::CLRc()  { clear_S_Bit( Cy ); }
 void I51Core::SETBc() { set_S_Bit( Cy ); }
 void I51Core::CPLc()  { *m_STATUS ^= 1 << Cy; }
 
-void I51Core::CLRb()  { SET_RAM( m_bitAddr, m_dataMem[m_bitAddr] & ~m_bitMask ); }
-void I51Core::SETBb() { SET_RAM( m_bitAddr, m_dataMem[m_bitAddr] |  m_bitMask ); }
-void I51Core::CPLb()  { SET_RAM( m_bitAddr, m_dataMem[m_bitAddr] ^  m_bitMask ); }
+void I51Core::CLRb()  { setRam( m_bitAddr, m_dataMem[m_bitAddr] & ~m_bitMask ); }
+void I51Core::SETBb() { setRam( m_bitAddr, m_dataMem[m_bitAddr] |  m_bitMask ); }
+void I51Core::CPLb()  { setRam( m_bitAddr, m_dataMem[m_bitAddr] ^  m_bitMask ); }
 
 void I51Core::CJNE()  ///
 {
@@ -381,13 +381,13 @@ void I51Core::CJNE()  ///
 
 void I51Core::DJNZ()
 {
-    int value = GET_RAM( m_op0 )-1; // m_op0 = Rx or Dir
-    SET_RAM( m_op0, value );
+    int value = getRam( m_op0 )-1; // m_op0 = Rx or Dir
+    setRam( m_op0, value );
     if( value ) m_PC += (int8_t)m_opAddr;
 }
 
 void I51Core::PUSH() { pushStack8( m_op0 ); }
-void I51Core::POP()  { SET_RAM( m_opAddr, popStack8() ); }
+void I51Core::POP()  { setRam( m_opAddr, popStack8() ); }
 
 void I51Core::CLRa()  { ACC = 0; }
 void I51Core::CPLa()  { ACC = ~ACC; }
@@ -411,11 +411,11 @@ void I51Core::DAa()
 void I51Core::INCd()
 {
     //SET_REG16_LH( GET_REG16_LH( REG_DPL ) + 1);
-    SET_RAM( REG_DPL, m_dataMem[ REG_DPL ]+1);
-    if( !m_dataMem[ REG_DPL ] ) SET_RAM( REG_DPH, m_dataMem[ REG_DPH ]+1 );
+    setRam( REG_DPL, m_dataMem[ REG_DPL ]+1);
+    if( !m_dataMem[ REG_DPL ] ) setRam( REG_DPH, m_dataMem[ REG_DPH ]+1 );
 }
-void I51Core::INC() { SET_RAM( m_opAddr, m_dataMem[ m_opAddr ]+1); }
-void I51Core::DEC() { SET_RAM( m_opAddr, m_dataMem[ m_opAddr ]-1); }
+void I51Core::INC() { setRam( m_opAddr, m_dataMem[ m_opAddr ]+1); }
+void I51Core::DEC() { setRam( m_opAddr, m_dataMem[ m_opAddr ]-1); }
 
 void I51Core::ADD() { addFlags( m_op0, ACC, 0 ); ACC += m_op0; }
 void I51Core::ADDC()
@@ -424,9 +424,9 @@ void I51Core::ADDC()
     addFlags( m_op0, ACC, carry );
     ACC += m_op0 + carry;
 }
-void I51Core::ORLm() { SET_RAM( m_opAddr, m_dataMem[ m_opAddr ] | m_op0 ); }
-void I51Core::ANLm() { SET_RAM( m_opAddr, m_dataMem[ m_opAddr ] & m_op0 ); }
-void I51Core::XRLm() { SET_RAM( m_opAddr, m_dataMem[ m_opAddr ] ^ m_op0 ); }
+void I51Core::ORLm() { setRam( m_opAddr, m_dataMem[ m_opAddr ] | m_op0 ); }
+void I51Core::ANLm() { setRam( m_opAddr, m_dataMem[ m_opAddr ] & m_op0 ); }
+void I51Core::XRLm() { setRam( m_opAddr, m_dataMem[ m_opAddr ] ^ m_op0 ); }
 
 void I51Core::ORLa() { ACC |= m_op0; }
 void I51Core::ANLa() { ACC &= m_op0; }
@@ -442,8 +442,8 @@ void I51Core::SUBB()
 void I51Core::XCH() //
 {
     uint8_t a = ACC ;
-    ACC = GET_RAM( m_opAddr );
-    SET_RAM( m_opAddr, a );
+    ACC = getRam( m_opAddr );
+    setRam( m_opAddr, a );
 }
 
 void I51Core::XCHr() //
@@ -468,7 +468,7 @@ void I51Core::DIVab()
 
     if( B ){
         ACC = A/B;
-        SET_RAM( REG_B, A % B );
+        setRam( REG_B, A % B );
         clear_S_Bit( OV );
     }
     else set_S_Bit( OV );
@@ -480,15 +480,15 @@ void I51Core::MULab()
 {
     uint res = ACC*m_dataMem[ REG_B ];
     ACC = res & 0xFF;
-    SET_RAM( REG_B, res >> 8 );
+    setRam( REG_B, res >> 8 );
 
-    //write_S_Bit( OV, GET_RAM( REG_B ) );  /// FIXME ????
+    //write_S_Bit( OV, getRam( REG_B ) );  /// FIXME ????
     clear_S_Bit( OV );
     clear_S_Bit( Cy );
 }
 
 void I51Core::MOVr()  { m_dataMem[ m_opAddr ] = m_op0; }
-void I51Core::MOVm()  { SET_RAM( m_opAddr, m_op0 ); }
+void I51Core::MOVm()  { setRam( m_opAddr, m_op0 ); }
 void I51Core::MOVml() { writeInd( m_opAddr, m_op0 ); }
 
 void I51Core::MOVa()  { ACC = m_op0; }
@@ -18,7 +18,7 @@
     EXCEPTION_ILLEGAL_OPCODE     // for the single 'reserved' opcode in the architecture
 };*/
 
-class I51Core : public McuCpu, public eElement
+class I51Core final : public McuCpu, public eElement
 {
     public:
         I51Core( eMcu* mcu );
@@ -155,7 +155,7 @@ class I51Core : public McuCpu, public eElement
         inline uint8_t readInd( uint16_t addr )
         {
             addr = checkAddr( addr );
-            return McuCpu::GET_RAM( addr );
+            return McuCpu::getRam( addr );
         }
 
         inline void writeInd( uint16_t addr, uint8_t val )
@@ -14,6 +14,7 @@ McuCpu::McuCpu( eMcu* mcu )
     m_progMem    = mcu->m_progMem.data();
     m_progSize   = mcu->flashSize();
 
+    m_regStart = mcu->m_regStart;
     if( mcu->m_regStart > 0 ) m_lowDataMemEnd = mcu->m_regStart-1;
     else                      m_lowDataMemEnd = 0;
 
@@ -25,6 +25,7 @@ class McuCpu : public CpuBase
         uint8_t m_progAddrSize;
 
         uint16_t  m_lowDataMemEnd;
+        uint16_t  m_regStart;
         uint16_t  m_regEnd;
 
         /*uint8_t* m_spl;     // STACK POINTER low byte
@@ -45,22 +46,32 @@ class McuCpu : public CpuBase
             m_mcu->cyclesDone = m_retCycles;
         }
 
-        virtual uint8_t GET_RAM( uint16_t addr )                   // All MCUs should use this
+        // Data memory access, not virtual so it can be inlined:
+        // cores call getRam()/setRam() (or their own versions) directly.
+        // GET_RAM()/SET_RAM() are for callers that only know McuCpu.
+        inline uint8_t getRam( uint16_t addr )
         {
-            if( addr >= m_mcu->m_regStart && addr <= m_regEnd )    // Read Register
-                return m_mcu->readReg( addr );                     // and call Watchers
-
-            else if( addr <= m_dataMemEnd ) return m_dataMem[addr];// Read Ram
-            return 0;
+            if( addr > m_regEnd || addr < m_regStart )             // Not a Register
+            {
+                if( addr <= m_dataMemEnd ) return m_dataMem[addr]; // Read Ram
+                return 0;
+            }
+            return m_mcu->readReg( addr );                         // Read Register and call Watchers
         }
-        virtual void SET_RAM( uint16_t addr, uint8_t v )           // All MCUs should use this
+        inline void setRam( uint16_t addr, uint8_t v )
         {
-            if( (addr >= m_mcu->m_regStart) && (addr <= m_regEnd) )// Write Register
-                m_mcu->writeReg( addr, v );                        // and call Watchers
-
-            else if( addr <= m_dataMemEnd ) m_dataMem[addr] = v;   // Write Ram
+            if( addr > m_regEnd || addr < m_regStart )             // Not a Register
+            {
+                if( addr > m_dataMemEnd ) return;
+                m_mcu->checkWatch( addr, v );                      // Write Ram
+                m_dataMem[addr] = v;
+            }
+            else m_mcu->writeReg( addr, v );                       // Write Register and call Watchers
         }
 
+        virtual uint8_t GET_RAM( uint16_t addr ) { return getRam( addr ); }
+        virtual void SET_RAM( uint16_t addr, uint8_t v ) { setRam( addr, v ); }
+
         void SET_REG16_LH( uint16_t addr, uint16_t val )
         {
             m_mcu->writeReg( addr, val );
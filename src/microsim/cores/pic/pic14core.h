@@ -8,8 +8,10 @@
 
 #include "picmrcore.h"
 
-class Pic14Core : public PicMrCore
+class Pic14Core final : public PicMrCore<Pic14Core>
 {
+        friend class PicMrCore<Pic14Core>;
+
     public:
         Pic14Core( eMcu* mcu );
         ~Pic14Core();
@@ -20,22 +22,24 @@ protected:
         uint8_t* m_FSR;
         uint8_t m_WregHidden;
 
-        virtual uint8_t GET_RAM( uint16_t addr ) override //
+        inline uint8_t getRam( uint16_t addr )
         {
             addr = m_mcu->getMapperAddr( addr+m_bank );
 
             if( addr == 0 ) addr = getINDF();// INDF
-            return McuCpu::GET_RAM( addr );
+            return McuCpu::getRam( addr );
         }
-        virtual void SET_RAM( uint16_t addr, uint8_t v ) override //
+        inline void setRam( uint16_t addr, uint8_t v )
         {
             addr = m_mcu->getMapperAddr( addr+m_bank );
 
             if( addr == m_PCLaddr ) setPC( v + (m_dataMem[m_PCHaddr]<<8) ); // Writting to PCL
             else if( addr == 0 ) addr = getINDF();      // INDF
 
-            McuCpu::SET_RAM( addr, v );
+            McuCpu::setRam( addr, v );
         }
+        virtual uint8_t GET_RAM( uint16_t addr ) override { return getRam( addr ); }
+        virtual void SET_RAM( uint16_t addr, uint8_t v ) override { setRam( addr, v ); }
         inline uint16_t getINDF()
         {
             uint16_t  addr = *m_FSR;
@@ -8,8 +8,10 @@
 
 #include "picmrcore.h"
 
-class Pic14eCore : public PicMrCore
+class Pic14eCore final : public PicMrCore<Pic14eCore>
 {
+        friend class PicMrCore<Pic14eCore>;
+
     public:
         Pic14eCore( eMcu* mcu );
         ~Pic14eCore();
@@ -39,7 +41,7 @@ class Pic14eCore : public PicMrCore
             *m_FSR1H = (fsr1 & 0xFF00)>>8;
         }
 
-        virtual uint8_t GET_RAM( uint16_t addr ) override //
+        inline uint8_t getRam( uint16_t addr )
         {
             addr = m_mcu->getMapperAddr( addr+m_bank );
 
@@ -61,16 +63,18 @@ class Pic14eCore : public PicMrCore
                      return m_progMem[addr];
                 }
             }
-            return McuCpu::GET_RAM( addr );
+            return McuCpu::getRam( addr );
         }
-        virtual void SET_RAM( uint16_t addr, uint8_t v ) override //
+        inline void setRam( uint16_t addr, uint8_t v )
         {
             addr = m_mcu->getMapperAddr( addr+m_bank );
             if( addr == m_PCLaddr ) setPC( v + (m_dataMem[m_PCHaddr]<<8) ); // Writting to PCL
             else if( addr == 0 ) addr = getFSR0(); // INDF0
             else if( addr == 1 ) addr = getFSR1(); // INDF1
-            McuCpu::SET_RAM( addr, v );
+            McuCpu::setRam( addr, v );
         }
+        virtual uint8_t GET_RAM( uint16_t addr ) override { return getRam( addr ); }
+        virtual void SET_RAM( uint16_t addr, uint8_t v ) override { setRam( addr, v ); }
 
         // Miscellaneous instructions
         //inline void RESET();
@@ -3,11 +3,13 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
-#include "picmrcore.h"
+#include "pic14core.h"
+#include "pic14ecore.h"
 #include "datautils.h"
 #include "regwatcher.h"
 
-PicMrCore::PicMrCore( eMcu* mcu )
+template<class Core>
+PicMrCore<Core>::PicMrCore( eMcu* mcu )
          : McuCpu( mcu )
 {
     m_sp = 0;
@@ -16,22 +18,26 @@ PicMrCore::PicMrCore( eMcu* mcu )
     m_PCLaddr = mcu->getRegAddress("PCL");
     m_PCHaddr = mcu->getRegAddress("PCLATH");
 }
-PicMrCore::~PicMrCore() {}
+template<class Core>
+PicMrCore<Core>::~PicMrCore() {}
 
-void PicMrCore::reset()
+template<class Core>
+void PicMrCore<Core>::reset()
 {
     CpuBase::reset();
 
     *m_Wreg = 0;
 }
 
-void PicMrCore::setBank( uint8_t bank )
+template<class Core>
+void PicMrCore<Core>::setBank( uint8_t bank )
 {
     m_bank = getRegBitsVal( bank, m_bankBits );
     m_bank <<= 7;
 }
 
-uint8_t PicMrCore::add( uint8_t val1, uint8_t val2 )
+template<class Core>
+uint8_t PicMrCore<Core>::add( uint8_t val1, uint8_t val2 )
 {
     uint16_t newV = val1 + val2;
     write_S_Bit( Z, (newV & 0xFF)==0 );
@@ -40,7 +46,8 @@ uint8_t PicMrCore::add( uint8_t val1, uint8_t val2 )
     return newV;
 }
 
-uint8_t PicMrCore::sub( uint8_t val1, uint8_t val2 )
+template<class Core>
+uint8_t PicMrCore<Core>::sub( uint8_t val1, uint8_t val2 )
 {
     int16_t newV = val1 - val2;
     write_S_Bit( Z, (newV & 0xFF)==0 );
@@ -51,22 +58,28 @@ uint8_t PicMrCore::sub( uint8_t val1, uint8_t val2 )
 
 // Miscellaneous instructions
 
-inline void PicMrCore::RETURN() { RET(); }
+template<class Core>
+inline void PicMrCore<Core>::RETURN() { RET(); }
 
-inline void PicMrCore::RETFIE() { RETI(); }
+template<class Core>
+inline void PicMrCore<Core>::RETFIE() { RETI(); }
 
-inline void PicMrCore::OPTION() { *m_OPTION = *m_Wreg; }
+template<class Core>
+inline void PicMrCore<Core>::OPTION() { *m_OPTION = *m_Wreg; }
 
-inline void PicMrCore::SLEEP()
+template<class Core>
+inline void PicMrCore<Core>::SLEEP()
 {
     write_S_Bit( PD, false );
     write_S_Bit( TO, true );
     m_mcu->sleep( true );
 }
 
-void PicMrCore::exitSleep() { write_S_Bit( TO, false ); }
+template<class Core>
+void PicMrCore<Core>::exitSleep() { write_S_Bit( TO, false ); }
 
-inline void PicMrCore::CLRWDT()
+template<class Core>
+inline void PicMrCore<Core>::CLRWDT()
 {
     write_S_Bit( PD, true );
     write_S_Bit( TO, true );
@@ -74,150 +87,172 @@ inline void PicMrCore::CLRWDT()
 
 // ALU operations: dest ← OP(f,W)
 
-inline void PicMrCore::MOVWF( uint8_t f )
+template<class Core>
+inline void PicMrCore<Core>::MOVWF( uint8_t f )
 {
-    SET_RAM( f, *m_Wreg);
+    writeF( f, *m_Wreg);
 }
 
-inline void PicMrCore::CLRF( uint8_t f )
+template<class Core>
+inline void PicMrCore<Core>::CLRF( uint8_t f )
 {
-    SET_RAM( f, 0 );
+    writeF( f, 0 );
     write_S_Bit( Z, true );
 }
 
-inline void PicMrCore::SUBWF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::SUBWF( uint8_t f, uint8_t d )
 {
-    uint8_t newV = sub( GET_RAM( f ), *m_Wreg );
+    uint8_t newV = sub( readF( f ), *m_Wreg );
     setValue( newV, f, d );
 }
 
-inline void PicMrCore::DECF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::DECF( uint8_t f, uint8_t d )
 {
-    uint8_t newV = GET_RAM( f );
+    uint8_t newV = readF( f );
     setValueZ( --newV, f, d );
 }
 
-inline void PicMrCore::IORWF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::IORWF( uint8_t f, uint8_t d )
 {
-    uint8_t oldV = GET_RAM( f ) ;
+    uint8_t oldV = readF( f ) ;
     uint8_t newV = oldV | *m_Wreg;
     setValueZ( newV, f, d );
 }
 
-inline void PicMrCore::ANDWF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::ANDWF( uint8_t f, uint8_t d )
 {
-    uint8_t oldV = GET_RAM( f ) ;
+    uint8_t oldV = readF( f ) ;
     uint8_t newV = oldV & *m_Wreg;
     setValueZ( newV, f, d );
 }
 
-inline void PicMrCore::XORWF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::XORWF( uint8_t f, uint8_t d )
 {
-    uint8_t oldV = GET_RAM( f ) ;
+    uint8_t oldV = readF( f ) ;
     uint8_t newV = oldV ^ *m_Wreg;
     setValueZ( newV, f, d );
 }
 
-inline void PicMrCore::ADDWF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::ADDWF( uint8_t f, uint8_t d )
 {
-    uint8_t newV = add( GET_RAM( f ), *m_Wreg );
+    uint8_t newV = add( readF( f ), *m_Wreg );
     setValue( newV, f, d );
 }
 
-inline void PicMrCore::MOVF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::MOVF( uint8_t f, uint8_t d )
 {
-    uint8_t newV = GET_RAM( f );
+    uint8_t newV = readF( f );
     setValueZ( newV, f, d );
 }
 
-inline void PicMrCore::COMF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::COMF( uint8_t f, uint8_t d )
 {
-    uint8_t newV = GET_RAM( f ) ^ 0xFF;
+    uint8_t newV = readF( f ) ^ 0xFF;
     setValueZ( newV, f, d );
 }
 
-inline void PicMrCore::INCF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::INCF( uint8_t f, uint8_t d )
 {
-    uint8_t newV = GET_RAM( f );
+    uint8_t newV = readF( f );
     setValueZ( ++newV, f, d );
 }
 
-inline void PicMrCore::DECFSZ( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::DECFSZ( uint8_t f, uint8_t d )
 {
-    uint8_t newV = GET_RAM( f ) - 1;
+    uint8_t newV = readF( f ) - 1;
     setValue( newV, f, d );
     if( newV == 0 ) incDefault();
 }
 
-inline void PicMrCore::RRF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::RRF( uint8_t f, uint8_t d )
 {
-    uint8_t oldV = GET_RAM( f ) ;
+    uint8_t oldV = readF( f ) ;
     uint8_t newV = oldV >> 1;
     if( *m_STATUS & 1<<C ) newV |= 1<<7; // Carry In
     write_S_Bit( C, oldV & 1 );          // Carry Out
     setValue( newV, f, d );
 }
 
-inline void PicMrCore::RLF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::RLF( uint8_t f, uint8_t d )
 {
-    uint8_t oldV = GET_RAM( f ) ;
+    uint8_t oldV = readF( f ) ;
     uint8_t newV = oldV << 1;
     if( *m_STATUS & 1<<C ) newV |= 1; // Carry In
     write_S_Bit( C, oldV & 1<<7 );    // Carry Out
     setValue( newV, f, d );
 }
 
-inline void PicMrCore::SWAPF( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::SWAPF( uint8_t f, uint8_t d )
 {
-    uint8_t oldV = GET_RAM( f );
+    uint8_t oldV = readF( f );
     uint8_t newV = ((oldV >> 4) & 0x0F) | ((oldV << 4) & 0xF0);
     setValue( newV, f, d );
 }
 
-inline void PicMrCore::INCFSZ( uint8_t f, uint8_t d )
+template<class Core>
+inline void PicMrCore<Core>::INCFSZ( uint8_t f, uint8_t d )
 {
-    uint8_t newV = GET_RAM( f ) + 1;
+    uint8_t newV = readF( f ) + 1;
     setValue( newV, f, d );
     if( newV == 0 ) incDefault();
 }
 
 // Bit operations
 
-inline void PicMrCore::BCF( uint8_t f, uint8_t b )
+template<class Core>
+inline void PicMrCore<Core>::BCF( uint8_t f, uint8_t b )
 {
-    uint8_t newV = GET_RAM( f );
+    uint8_t newV = readF( f );
     newV &= ~(1<<b);
-    SET_RAM( f, newV );
+    writeF( f, newV );
 }
 
-inline void PicMrCore::BSF( uint8_t f, uint8_t b )
+template<class Core>
+inline void PicMrCore<Core>::BSF( uint8_t f, uint8_t b )
 {
-    uint8_t newV = GET_RAM( f );
+    uint8_t newV = readF( f );
     newV |= 1<<b;
-    SET_RAM( f, newV );
+    writeF( f, newV );
 }
 
-inline void PicMrCore::BTFSC( uint8_t f, uint8_t b )
+template<class Core>
+inline void PicMrCore<Core>::BTFSC( uint8_t f, uint8_t b )
 {
-    uint8_t oldV = GET_RAM( f );
+    uint8_t oldV = readF( f );
     uint8_t bitMask = 1<<b;
     if( (oldV & bitMask) == 0 ) incDefault();
 }
 
-inline void PicMrCore::BTFSS( uint8_t f, uint8_t b )
+template<class Core>
+inline void PicMrCore<Core>::BTFSS( uint8_t f, uint8_t b )
 {
-    uint8_t oldV = GET_RAM( f );
+    uint8_t oldV = readF( f );
     if( oldV & 1<<b  ) incDefault();
 }
 
 // Control transfers
 
-inline void PicMrCore::CALL( uint16_t k )
+template<class Core>
+inline void PicMrCore<Core>::CALL( uint16_t k )
 {
     CALL_ADDR( k | ((uint16_t)(m_dataMem[m_PCHaddr] & 0b00011000)<<8) );
 }
 
-inline void PicMrCore::GOTO( uint16_t k )
+template<class Core>
+inline void PicMrCore<Core>::GOTO( uint16_t k )
 {
     setPC( k | ((uint16_t)(m_dataMem[m_PCHaddr] & 0b00011000)<<8) );
     m_mcu->cyclesDone = 2;
@@ -225,46 +260,54 @@ inline void PicMrCore::GOTO( uint16_t k )
 
 // Operations with W and 8-bit literal: W ← OP(k,W)
 
-inline void PicMrCore::MOVLW( uint8_t k )
+template<class Core>
+inline void PicMrCore<Core>::MOVLW( uint8_t k )
 {
     *m_Wreg = k;
 }
 
-inline void PicMrCore::RETLW( uint8_t k )
+template<class Core>
+inline void PicMrCore<Core>::RETLW( uint8_t k )
 {
     *m_Wreg = k;
     RETURN();
 }
 
-inline void PicMrCore::IORLW( uint8_t k )
+template<class Core>
+inline void PicMrCore<Core>::IORLW( uint8_t k )
 {
     *m_Wreg |= k;
     write_S_Bit( Z, *m_Wreg==0 );
 }
 
-inline void PicMrCore::ANDLW( uint8_t k )
+template<class Core>
+inline void PicMrCore<Core>::ANDLW( uint8_t k )
 {
     *m_Wreg &= k;
     write_S_Bit( Z, *m_Wreg==0 );
 }
 
-inline void PicMrCore::XORLW( uint8_t k )
+template<class Core>
+inline void PicMrCore<Core>::XORLW( uint8_t k )
 {
     *m_Wreg ^= k;
     write_S_Bit( Z, *m_Wreg==0 );
 }
 
-inline void PicMrCore::SUBLW( uint8_t k ) //// C,DC,Z
+template<class Core>
+inline void PicMrCore<Core>::SUBLW( uint8_t k ) //// C,DC,Z
 {
     *m_Wreg = sub( k, *m_Wreg );
 }
 
-inline void PicMrCore::ADDLW( uint8_t k ) //// C,DC,Z
+template<class Core>
+inline void PicMrCore<Core>::ADDLW( uint8_t k ) //// C,DC,Z
 {
     *m_Wreg = add( k, *m_Wreg );
 }
 
-void PicMrCore::runStep()
+template<class Core>
+void PicMrCore<Core>::runStep()
 {
     uint16_t instr = m_progMem[m_PC] & 0x3FFF;
 
@@ -275,7 +318,8 @@ void PicMrCore::runStep()
     runStep( instr );
 }
 
-void PicMrCore::runStep( uint16_t instr )
+template<class Core>
+void PicMrCore<Core>::runStep( uint16_t instr )
 {
     if( (instr & 0x3F80) == 0 )  // Miscellaneous instrs
     {
@@ -364,3 +408,6 @@ void PicMrCore::runStep( uint16_t instr )
         }
     }
 }
+
+template class PicMrCore<Pic14Core>;
+template class PicMrCore<Pic14eCore>;
@@ -12,6 +12,11 @@ enum {
     C=0,DC,Z,PD,TO,RP0,RP1,IRP
 };
 
+// Core: final class (Pic14Core, Pic14eCore) providing getRam()/setRam()
+// with its banking and indirect addressing. Instructions call them
+// directly, so data access is resolved and inlined at compile time.
+
+template<class Core>
 class PicMrCore : public McuCpu
 {
     public:
@@ -65,9 +70,12 @@ class PicMrCore : public McuCpu
             m_dataMem[ m_PCLaddr] = m_PC & 0xFF;
         }
 
+        inline uint8_t readF( uint16_t f ) { return static_cast<Core*>( this )->getRam( f ); }
+        inline void writeF( uint16_t f, uint8_t v ) { static_cast<Core*>( this )->setRam( f, v ); }
+
         void setValue( uint8_t newV, uint8_t f, uint8_t d )
         {
-            if( d ) SET_RAM( f, newV );
+            if( d ) writeF( f, newV );
             else    *m_Wreg = newV;
         }
         void setValueZ( uint8_t newV, uint8_t f, uint8_t d )
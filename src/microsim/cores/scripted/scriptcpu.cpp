@@ -26,6 +26,7 @@ ScriptCpu::ScriptCpu( eMcu* mcu )
          , McuCpu( mcu )
 {
     m_watcher  = nullptr;
+    mcu->addScript( this );
 
     m_progWordMask = 0;
     for( uint i=0; i<mcu->wordSize(); ++i )
@@ -250,6 +251,11 @@ int ScriptCpu::compileScript()
     m_setLinkedVal= module->GetFunctionByDecl("void setLinkedValue( double v, int i )");
     m_setLinkedStr= module->GetFunctionByDecl("void setLinkedString( string str, int i )");
 
+    if( m_vChangedCtx ) m_vChangedCtx->Release(); // Rebuilt module
+    if( m_runEventCtx ) m_runEventCtx->Release();
+    if( m_extClockCtx ) m_extClockCtx->Release();
+    if( m_runStepCtx  ) m_runStepCtx->Release();
+
     m_vChangedCtx = m_voltChanged ? m_aEngine->CreateContext() : nullptr;
     m_runEventCtx = m_runEvent    ? m_aEngine->CreateContext() : nullptr;
     m_extClockCtx = m_extClockF   ? m_aEngine->CreateContext() : nullptr;
@@ -312,10 +318,10 @@ void ScriptCpu::voltChanged()
     if( !m_voltChanged ) return;
 
 #ifdef __x86_64__
-    m_status = m_vChangedCtx->executeJit0( m_voltChanged );
-#else
-    m_status = callFunction0( m_voltChanged, m_vChangedCtx );
+    if( !m_profiling ) m_status = m_vChangedCtx->executeJit0( m_voltChanged );
+    else
 #endif
+    m_status = callFunction0( m_voltChanged, m_vChangedCtx );
     if( m_status != asEXECUTION_FINISHED ) printError( m_vChangedCtx );
 }
 
@@ -323,10 +329,10 @@ void ScriptCpu::runEvent()
 {
     if( !m_runEvent ) return;
 #ifdef __x86_64__
-    m_status = m_runEventCtx->executeJit0( m_runEvent );
-#else
-    m_status = callFunction0( m_runEvent, m_runEventCtx );
+    if( !m_profiling ) m_status = m_runEventCtx->executeJit0( m_runEvent );
+    else
 #endif
+    m_status = callFunction0( m_runEvent, m_runEventCtx );
     if( m_status != asEXECUTION_FINISHED ) printError( m_runEventCtx );
 }
 
@@ -343,10 +349,10 @@ void ScriptCpu::runStep()
     if( !m_runStep ) return;
     m_mcu->cyclesDone = 1;
 #ifdef __x86_64__
-    m_status = m_runStepCtx->executeJit0( m_runStep );
-#else
-    m_status = callFunction0( m_runStep, m_runStepCtx );
+    if( !m_profiling ) m_status = m_runStepCtx->executeJit0( m_runStep );
+    else
 #endif
+    m_status = callFunction0( m_runStep, m_runStepCtx );
     if( m_status != asEXECUTION_FINISHED ) printError( m_runStepCtx );
 }
 
@@ -355,10 +361,10 @@ void ScriptCpu::extClock( bool clkState )
     if( m_extClockF )
     {
 #ifdef __x86_64__
-        m_status = m_extClockCtx->executeJit0( m_extClockF );
-#else
-        m_status = callFunction0( m_extClockF , m_extClockCtx );
+        if( !m_profiling ) m_status = m_extClockCtx->executeJit0( m_extClockF );
+        else
 #endif
+        m_status = callFunction0( m_extClockF , m_extClockCtx );
         if( m_status != asEXECUTION_FINISHED ) printError( m_extClockCtx );
     }
     if( !m_extClock ) return;
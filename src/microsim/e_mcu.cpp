@@ -3,6 +3,9 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+#include <string.h>
+
 #include "e_mcu.h"
 #include "mcu.h"
 #include "cpubase.h"
@@ -16,6 +19,7 @@
 #include "usartrx.h"
 #include "mcuvref.h"
 #include "simulator.h"
+#include "simtrace.h"
 #include "basedebugger.h"
 #include "editorwindow.h"
 
@@ -128,22 +132,64 @@ void eMcu::voltChanged()  // External clock
 void eMcu::runEvent()
 {
     if( m_state != mcuRunning ) return;
+    TRACE_SPAN("eMcu::runEvent");
 
-    if( m_debugging )
+    if( m_debugging && !m_debugger->m_running )
     {
         if( cyclesDone > 1 ) cyclesDone -= 1;
         else                 m_debugger->stepDebug();
+        if( m_watchHit ) watchReached();
         Simulator::self()->addEvent( m_psTick, this );
     }
     else if( m_state >= mcuRunning && m_freq > 0 )
     {
         stepCpu();
+        if( m_debugging )                                        // Run to breakpoint
+        {
+            m_debugger->runStep( m_cpu->getPC() );
+            if( m_watchHit ) watchReached();
+        }
         int cycles = cyclesDone;
         if( cycles == 0 ) cycles = 1;                        // 8051: 2 Read cycles per Machine cycle
         Simulator::self()->addEvent( cycles*m_psTick, this );
     }
 }
 
+void eMcu::saveState( QDataStream& out ) // Ram includes all SFRs
+{
+    QByteArray ram( (const char*)m_dataMem.data(), m_dataMem.size() );
+    out << (quint8)m_state << (quint64)m_cycle << (qint32)cyclesDone << m_clkState << ram << m_eeprom;
+    m_interrupts.saveState( out );
+    if( m_cpu ) m_cpu->saveState( out );
+}
+
+void eMcu::loadState( QDataStream& in )
+{
+    quint8 state;
+    quint64 cycle;
+    qint32 cycles;
+    bool clkState;
+    QByteArray ram;
+    QVector<int> eeprom;
+    in >> state >> cycle >> cycles >> clkState >> ram >> eeprom;
+
+    if( (size_t)ram.size() != m_dataMem.size() || eeprom.size() != m_eeprom.size() )
+    {
+        qDebug() << "eMcu::loadState Error: Memory size doesn't match"<<getId();
+        in.setStatus( QDataStream::ReadCorruptData ); // Fail Checkpoint load
+        return;
+    }
+    m_state = (mcuState_t)state;
+    m_cycle = cycle;
+    cyclesDone = cycles;
+    m_clkState = clkState;
+    memcpy( m_dataMem.data(), ram.constData(), ram.size() );
+    m_eeprom = eeprom;
+
+    m_interrupts.loadState( in );
+    if( m_cpu ) m_cpu->loadState( in );
+}
+
 void eMcu::stepCpu()
 {
     if( !m_flashSize || m_cpu->getPC() < m_flashSize )
@@ -169,6 +215,13 @@ void eMcu::setDebugging( bool d )
 {
     m_debugger->m_prevLine.lineNumber = -1;
     m_debugging = d;
+    m_watchHit = false;
+}
+
+void eMcu::watchReached()
+{
+    m_watchHit = false;
+    m_debugger->watchReached( m_watchMsg );
 }
 
 void eMcu::start()
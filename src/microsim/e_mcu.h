@@ -39,6 +39,7 @@ class Component;
 class ConfigWord;
 class McuComp;
 class CpuBase;
+class ScriptBase;
 
 class eMcu : public DataSpace, public eIou
 {
@@ -58,6 +59,9 @@ class eMcu : public DataSpace, public eIou
         virtual void voltChanged() override;
         virtual void runEvent() override;
 
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
+
         inline mcuState_t state() { return m_state; }
         inline int sleepMode() { return m_sleepModule->mode(); }
 
@@ -115,10 +119,14 @@ class eMcu : public DataSpace, public eIou
 
         void setMain() { m_pSelf = this; }
 
+        void addScript( ScriptBase* s ) { m_scripts.push_back( s ); } // Scripted parts: used by Profiler
+        std::vector<ScriptBase*>* scripts() { return &m_scripts; }
+
     protected:
  static eMcu* m_pSelf;
 
         void reset();
+        void watchReached();
 
         QString m_firmware;     // firmware file loaded
 
@@ -137,6 +145,7 @@ class eMcu : public DataSpace, public eIou
 
         std::vector<McuModule*> m_modules;
         std::vector<McuUsart*> m_usarts;
+        std::vector<ScriptBase*> m_scripts;
 
         QHash<QString, McuTimer*> m_timerList;// Access TIMERS by name
         QHash<QString, McuPort*>  m_mcuPorts; // Access PORTS by name
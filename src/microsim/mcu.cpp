@@ -625,7 +625,7 @@ void Mcu::slotOpenMcuMonitor()
 
 void Mcu::slotOpenTerm( int num )
 {
-    m_eMcu.m_usarts.at(num-1)->openMonitor( findIdLabel(), num );
+    m_eMcu.m_usarts.at(num-1)->openMonitor( CircuitWidget::self(), findIdLabel(), num );
     m_serialMon = num;
 }
 
@@ -22,6 +22,7 @@ class McuAdc : public McuPrescaled, public eElement
 
         virtual void initialize() override;
         virtual void runEvent() override;
+        virtual bool unsavedState() override { return true; }
 
         virtual void setChannel( uint8_t val ){;}
 
@@ -346,6 +346,7 @@ void McuCreator::createDataMem( uint32_t size )
 {
     mcu->m_ramSize = size;
     mcu->m_dataMem.resize( size, 0 );
+    mcu->m_watchFlags.resize( size, 0 );
     mcu->m_addrMap.resize( size, 0xFFFF ); // Not Maped values = 0xFFFF -> don't exist
 }
 
@@ -1040,7 +1041,9 @@ void McuCreator::createAdc( QDomElement* e )
     for( QString pinName : pins )
     {
         McuPin* pin = mcu->getMcuPin( pinName );
-        if( pin ) adc->m_adcPin.emplace_back( pin );
+        if( !pin ) continue;
+        pin->setAnalogIn( true );
+        adc->m_adcPin.emplace_back( pin );
     }
     if( e->hasAttribute("vrefpins") )
     {
@@ -1048,7 +1051,9 @@ void McuCreator::createAdc( QDomElement* e )
         for( QString pinName : pins )
         {
             McuPin* pin = mcu->getMcuPin( pinName );
-            if( pin ) adc->m_refPin.emplace_back( pin );
+            if( !pin ) continue;
+            pin->setAnalogIn( true );
+            adc->m_refPin.emplace_back( pin );
     }   }
 }
 
@@ -1076,7 +1081,9 @@ void McuCreator::createDac( QDomElement* e )
         for( QString pinName : pins )
         {
             McuPin* pin = mcu->getMcuPin( pinName );
-            if( pin ) dac->m_pins.emplace_back( pin );
+            if( !pin ) continue;
+            pin->setAnalogIn( true );
+            dac->m_pins.emplace_back( pin );
     }   }
 }
 
@@ -1099,7 +1106,9 @@ void McuCreator::createAcomp( QDomElement* e )
     for( QString pinName : pins )
     {
         McuPin* pin = mcu->getMcuPin( pinName );
-        if( pin ) comp->m_pins.emplace_back( pin );
+        if( !pin ) continue;
+        pin->setAnalogIn( true );
+        comp->m_pins.emplace_back( pin );
     }
     setInterrupt( e->attribute("interrupt"), comp );
 }
@@ -4,9 +4,11 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <QDebug>
+#include <QRegExp>
 
 #include "mcudataspace.h"
 #include "datautils.h"
+#include "simulator.h"
 #include "utils.h"
 
 DataSpace::DataSpace()
@@ -15,6 +17,10 @@ DataSpace::DataSpace()
     m_ramSize   = 0;
     m_regStart = 0xFFFF;
     m_regEnd   = 0;
+
+    m_snapVersion = 0;
+    m_pageBits = 5;
+    m_watchHit = false;
 }
 
 DataSpace::~DataSpace()
@@ -76,7 +82,9 @@ void DataSpace::writeReg( uint16_t addr, uint8_t v, bool masked )
         regSignal->emitValue( v );
         if( m_regOverride >= 0 ) v = (uint8_t)m_regOverride; // Value overriden in callback
     }
-    if( mask != 0x00 ) m_dataMem[addr] = v;
+    if( mask == 0x00 ) return;
+    checkWatch( addr, v );
+    m_dataMem[addr] = v;
 }
 
 uint16_t DataSpace::getRegAddress( QString reg )// Get Reg address by name
@@ -106,6 +114,139 @@ uint8_t DataSpace::getRamValue( int address ) // Read RAM from Mcu Monitor
     return value;
 }
 
+void DataSpace::updateSnapshot() // Called from Mcu Monitor when Simulation thread is stopped
+{
+    uint32_t pageSize = 1<<m_pageBits;
+    uint32_t pages = (m_ramSize+pageSize-1)>>m_pageBits;
+
+    m_snapVersion++;
+    if( m_snapshot.size() != m_ramSize ) // First snapshot: all pages changed
+    {
+        m_snapshot.assign( m_ramSize, 0 );
+        m_pageVersion.assign( pages, m_snapVersion );
+    }
+    uint32_t dataSize = m_dataMem.size();
+    const uint8_t* data = m_dataMem.data();
+    uint8_t* snap = m_snapshot.data();
+
+    for( uint32_t page=0; page<pages; ++page )
+    {
+        uint32_t start = page<<m_pageBits;
+        uint32_t end = start+pageSize;
+        if( end > m_ramSize ) end = m_ramSize;
+
+        bool changed = false;
+        for( uint32_t addr=start; addr<end; ++addr )
+        {
+            uint16_t mapped = m_addrMap[addr];
+            uint8_t value = (mapped < dataSize) ? data[mapped] : 0;
+            if( snap[addr] == value ) continue;
+            snap[addr] = value;
+            changed = true;
+        }
+        if( changed ) m_pageVersion[page] = m_snapVersion;
+}   }
+
+bool DataSpace::setWatch( uint16_t addr, QString cond )
+{
+    if( addr >= m_watchFlags.size() ) return false;
+
+    dataCond_t c = { addr, OP_WRITE, 0 };
+    cond = cond.trimmed();
+    if( cond.toLower() == "changed" ) c.op = OP_CHANGE;
+    else if( !cond.isEmpty() )
+    {
+        QStringList words = cond.split(" ");
+        words.removeAll("");
+        if( words.size() != 2 || !parseOp( words.at(0), words.at(1), &c ) ) return false;
+    }
+    Simulator::self()->waitCircuit(); // Simulation thread reads watches
+    m_watches[addr] = c;
+    m_watchFlags[addr] = 1;
+    return true;
+}
+
+void DataSpace::remWatch( uint16_t addr )
+{
+    if( addr >= m_watchFlags.size() ) return;
+    Simulator::self()->waitCircuit();
+    m_watchFlags[addr] = 0;
+    m_watches.remove( addr );
+}
+
+void DataSpace::clearWatches()
+{
+    Simulator::self()->waitCircuit();
+    std::fill( m_watchFlags.begin(), m_watchFlags.end(), 0 );
+    m_watches.clear();
+}
+
+void DataSpace::watchWrite( uint16_t addr, uint8_t v ) // Only called for addresses with watchpoint
+{
+    dataCond_t c = m_watches.value( addr );
+    uint8_t oldVal = m_dataMem[addr];
+    if( !testCond( c, oldVal, v ) ) return;
+
+    m_watchHit = true;
+    m_watchMsg = "Watchpoint: 0x"+QString::number( addr, 16 ).toUpper()
+               +" = "+QString::number( v )+" (was "+QString::number( oldVal )+")";
+}
+
+bool DataSpace::testCond( const dataCond_t& c, uint8_t oldVal, uint8_t v )
+{
+    switch( c.op ){
+        case OP_WRITE:  return true;
+        case OP_CHANGE: return v != oldVal;
+        case OP_EQ:     return v == c.value;
+        case OP_NE:     return v != c.value;
+        case OP_LT:     return v <  c.value;
+        case OP_GT:     return v >  c.value;
+        case OP_LE:     return v <= c.value;
+        case OP_GE:     return v >= c.value;
+        case OP_AND:    return v &  c.value;
+    }
+    return false;
+}
+
+bool DataSpace::parseOp( QString opStr, QString valStr, dataCond_t* c )
+{
+    static const QStringList ops = { "==", "!=", "<", ">", "<=", ">=", "&" };
+    int op = ops.indexOf( opStr );
+    if( op < 0 ) return false;
+
+    bool ok = false;
+    int value = valStr.toInt( &ok, 0 );      // 0x.. hex, 0.. octal, else decimal
+    if( !ok || value < 0 || value > 255 ) return false;
+
+    c->op = OP_EQ+op;
+    c->value = value;
+    return true;
+}
+
+bool DataSpace::parseCond( QString cond, dataCond_t* c )
+{
+    QRegExp rx("^\\s*(\\S+)\\s*(==|!=|<=|>=|<|>|&)\\s*(\\S+)\\s*$");
+    if( rx.indexIn( cond ) < 0 ) return false;
+
+    QString name = rx.cap( 1 );
+    int addr = -1;
+    if( regExist( name ) ) addr = getRegAddress( name );
+    else{
+        addr = m_ramTable ? m_ramTable->varAddress( name ) : -1;
+        if( addr < 0 )
+        {
+            bool ok = false;
+            addr = name.toInt( &ok, 0 );
+            if( !ok ) addr = -1;
+        }
+        if( addr >= 0 && (uint)addr < m_addrMap.size() ) addr = getMapperAddr( addr );
+    }
+    if( addr < 0 || (uint)addr >= m_dataMem.size() ) return false;
+
+    c->addr = addr;
+    return parseOp( rx.cap( 2 ), rx.cap( 3 ), c );
+}
+
 void DataSpace::setRamValue( int address, uint8_t value ) // Setting RAM from external source (McuMonitor)
 { writeReg( getMapperAddr(address), value ); }
 
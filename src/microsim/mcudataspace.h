@@ -14,6 +14,24 @@
 
 class RamTable;
 
+enum dataOp_t{    // Data conditions: watchpoints and conditional breakpoints
+    OP_WRITE=0,   // Any write
+    OP_CHANGE,    // Value changed
+    OP_EQ,
+    OP_NE,
+    OP_LT,
+    OP_GT,
+    OP_LE,
+    OP_GE,
+    OP_AND        // Any bit in mask set
+};
+
+struct dataCond_t{
+    uint16_t addr;  // Address in Data space (mapped)
+    uint8_t  op;
+    uint8_t  value;
+};
+
 class DataSpace
 {
     public:
@@ -28,6 +46,18 @@ class DataSpace
         uint8_t* getRam() { return m_dataMem.data(); }  // Get pointer to Ram data
         uint16_t getMapperAddr( uint16_t addr ) { return m_addrMap[addr]; } // Get mapped addresses in Data space
 
+        // RAM snapshot for monitors: plain copy, read watchers are not called.
+        // A page changed since "version" if pageVersion > version.
+        void     updateSnapshot();
+        uint8_t  snapshotValue( uint32_t address ) { return (address < m_snapshot.size()) ? m_snapshot[address] : 0; }
+        uint32_t snapshotVersion() { return m_snapVersion; }
+        uint32_t snapshotPageSize() { return 1<<m_pageBits; }
+        bool     pageChanged( uint32_t address, uint32_t version )
+        {
+            if( address >= m_snapshot.size() ) return false;
+            return m_pageVersion[address>>m_pageBits] > version;
+        }
+
         uint16_t getRegAddress( QString reg );  // Get Reg address by name
         uint8_t* getReg( QString reg );            // Get pointer to Reg data by name
         bool     regExist( QString reg ) { return m_regInfo.contains( reg ); }
@@ -47,6 +77,17 @@ class DataSpace
 
         bool isCpuRead() { return m_isCpuRead; }
 
+        // Data watchpoints: per address flag checked at each write, one branch if not used.
+        // cond: "" (any write), "changed" or "op value", ex: "== 0x10", "& 4"
+        // Changed from GUI thread: waits until Simulation thread is stopped.
+        bool setWatch( uint16_t addr, QString cond );
+        void remWatch( uint16_t addr );
+        void clearWatches();
+        bool hasWatch( uint16_t addr ) { return (addr < m_watchFlags.size()) && m_watchFlags[addr]; }
+
+        bool parseCond( QString cond, dataCond_t* c ); // "name op value": name is Register, variable or address
+        bool evalCond( const dataCond_t& c ) { return testCond( c, m_dataMem[c.addr], m_dataMem[c.addr] ); }
+
         int m_regOverride;                         // Register value is overriden at write time
 
     protected:
@@ -59,6 +100,11 @@ class DataSpace
         std::vector<uint16_t> m_addrMap;           // Maps addresses in Data space
         std::vector<uint8_t>  m_regMask;           // Registers Write mask
 
+        std::vector<uint8_t>  m_snapshot;          // RAM copy as seen by monitors
+        std::vector<uint32_t> m_pageVersion;       // Snapshot version of last change in each page
+        uint32_t m_snapVersion;
+        int      m_pageBits;                       // Page size = 2^m_pageBits bytes
+
         QHash<QString, regInfo_t>   m_regInfo;     // Access Reg Info by  Reg name
         QHash<uint16_t, McuSignal*> m_readSignals; // Access read Reg Signals by Reg address
         QHash<uint16_t, McuSignal*> m_writeSignals;// Access write Reg Signals by Reg address
@@ -69,6 +115,16 @@ class DataSpace
         QStringList m_statusBits;
 
         RamTable* m_ramTable;
+
+        inline void checkWatch( uint16_t addr, uint8_t v ) { if( m_watchFlags[addr] ) watchWrite( addr, v ); }
+        void watchWrite( uint16_t addr, uint8_t v );
+ static bool parseOp( QString opStr, QString valStr, dataCond_t* c );
+ static bool testCond( const dataCond_t& c, uint8_t oldVal, uint8_t v );
+
+        std::vector<uint8_t> m_watchFlags;         // Address has a watchpoint
+        QHash<uint16_t, dataCond_t> m_watches;
+        bool    m_watchHit;
+        QString m_watchMsg;
 };
 
 #endif
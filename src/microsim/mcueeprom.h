@@ -18,6 +18,7 @@ class McuEeprom : public McuModule, public eElement
         virtual ~McuEeprom();
 
         virtual void initialize() override;
+        virtual bool unsavedState() override { return true; }
 
         virtual void readEeprom();
         virtual void writeEeprom();
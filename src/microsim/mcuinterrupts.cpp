@@ -4,6 +4,7 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <QDebug>
+#include <QDataStream>
 
 #include "mcuinterrupts.h"
 #include "cpubase.h"
@@ -250,6 +251,59 @@ void Interrupts::remFromPending( Interrupt* remInt )
         posInt = posInt->m_nextInt;
 }   }
 
+void Interrupts::saveState( QDataStream& out )
+{
+    out << (quint32)m_intList.size();
+    for( Interrupt* inte : m_intList )
+        out << inte->m_enabled << inte->m_priority << inte->m_raised << inte->m_autoClear << inte->m_continuous;
+
+    QStringList pending, running;
+    for( Interrupt* inte=m_pending; inte; inte=inte->m_nextInt ) pending.append( inte->m_name );
+    for( Interrupt* inte=m_running; inte; inte=inte->m_nextInt ) running.append( inte->m_name );
+    QString active = m_active ? m_active->m_name : "";
+
+    out << m_enabled << m_reti << active << pending << running;
+}
+
+void Interrupts::loadState( QDataStream& in ) // Pending and running lists are rebuilt in saved order
+{
+    quint32 size;
+    in >> size;
+    if( size != (quint32)m_intList.size() )
+    {
+        qDebug() << "Interrupts::loadState Error: Interrupts don't match";
+        in.setStatus( QDataStream::ReadCorruptData );
+        return;
+    }
+    for( Interrupt* inte : m_intList )
+    {
+        inte->m_nextInt = NULL;
+        in >> inte->m_enabled >> inte->m_priority >> inte->m_raised >> inte->m_autoClear >> inte->m_continuous;
+    }
+    QString active;
+    QStringList pending, running;
+    in >> m_enabled >> m_reti >> active >> pending >> running;
+
+    m_active  = m_intList.value( active );
+    m_pending = listFromNames( pending );
+    m_running = listFromNames( running );
+}
+
+Interrupt* Interrupts::listFromNames( QStringList names )
+{
+    Interrupt* first = NULL;
+    Interrupt* last  = NULL;
+    for( QString name : names )
+    {
+        Interrupt* inte = m_intList.value( name );
+        if( !inte ) continue;
+        if( last ) last->m_nextInt = inte;
+        else       first = inte;
+        last = inte;
+    }
+    return first;
+}
+
 Interrupt* Interrupts::getInterrupt( QString name )
 {
     return m_intList.value( name );
@@ -8,18 +8,21 @@
 
 #include <QString>
 #include <QMap>
+#include <QStringList>
 #include <map>
 
 #include "mcutypes.h"
 
 class eMcu;
 class Interrupts;
+class QDataStream;
 class McuModule;
 class IoPin;
 
 class Interrupt
 {
         friend class McuCreator;
+        friend class Interrupts;
 
     public:
         Interrupt( QString name, uint16_t vector, eMcu* mcu );
@@ -97,12 +100,17 @@ class Interrupts
         void resetInts();
         void writeGlobalFlag( uint8_t flag );
 
+        void saveState( QDataStream& out ); // Checkpoint: Interrupt flags are also in Ram
+        void loadState( QDataStream& in );
+
         void addToPending( Interrupt* newInt );
         void remFromPending( Interrupt* remInt );
 
         Interrupt* getInterrupt( QString name );
 
     protected:
+        Interrupt* listFromNames( QStringList names );
+
         eMcu* m_mcu;
 
         bool m_reti;
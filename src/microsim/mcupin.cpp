@@ -98,7 +98,7 @@ void McuPin::setPortState( bool state ) // Port Is being witten
     if( m_outCtrl ) return; // Port is not controlling Pin State
 
     m_outState = state; /// ??? Should this be controlled by IoPin?
-    if( m_isOut ) IoPin::scheduleState( state, 0 );
+    if( m_isOut ) m_port->outBus()->scheduleState( this, state );
 }
 
 void McuPin::setOutState( bool state ) // Some periferical is controlling this Pin
@@ -14,6 +14,7 @@
 
 McuPort::McuPort( eMcu* mcu, QString name )
        : McuModule( mcu, name )
+       , m_outBus( name+"-outBus" )
 {
     m_numPins = 0;
 
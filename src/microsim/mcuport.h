@@ -10,6 +10,7 @@
 
 #include "mcumodule.h"
 #include "mcupin.h"
+#include "iobus.h"
 
 class Mcu;
 class eMcu;
@@ -52,6 +53,8 @@ class McuPort : public McuModule
         uint getInpState();                  // Direct control over pins
         void setPinMode( pinMode_t mode );   // Direct control over pins
 
+        IoBus* outBus() { return &m_outBus; }
+
         //uint16_t getOutAddr() { return m_outAddr; }
         //uint16_t getInAddr() { return m_inAddr; }
 
@@ -64,6 +67,7 @@ class McuPort : public McuModule
         QString m_shortName;
 
         std::vector<McuPin*> m_pins;
+        IoBus m_outBus;      // Pins written at the same time share output edge
         uint8_t m_numPins;
         uint8_t m_pinState;
 
@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "mcutimer.h"
 #include "e_mcu.h"
 #include "mcupin.h"
@@ -69,6 +71,28 @@ void McuTimer::voltChanged()  // External Clock Pin changed voltage
     m_clkState = state;
 }
 
+void McuTimer::saveState( QDataStream& out ) // Count registers are in Ram
+{
+    out << m_running << m_bidirec << m_reverse << m_extClock << m_clkState << m_clkEdge << m_mode
+        << m_prIndex << m_prescaler << (quint64)m_psPerTick
+        << m_countVal << m_countStart << m_ovfMatch << m_ovfPeriod
+        << (quint64)m_ovfTime << (quint64)m_timeOffset << (quint64)m_circTime;
+}
+
+void McuTimer::loadState( QDataStream& in )
+{
+    quint64 psPerTick, ovfTime, timeOffset, circTime;
+    in >> m_running >> m_bidirec >> m_reverse >> m_extClock >> m_clkState >> m_clkEdge >> m_mode
+       >> m_prIndex >> m_prescaler >> psPerTick
+       >> m_countVal >> m_countStart >> m_ovfMatch >> m_ovfPeriod
+       >> ovfTime >> timeOffset >> circTime;
+
+    m_psPerTick  = psPerTick;
+    m_ovfTime    = ovfTime;
+    m_timeOffset = timeOffset;
+    m_circTime   = circTime;
+}
+
 void McuTimer::sleep( int mode )
 {
     McuModule::sleep( mode );
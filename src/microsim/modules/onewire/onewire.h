@@ -36,6 +36,7 @@ class OneWire : public eElement
         void stamp() override;
         void voltChanged() override;
         void runEvent() override;
+        bool unsavedState() override { return true; }
 
         QString getROM() { return arrayToHex( m_ROM, 8 ); }
         void setROM( QString ROMstr );
@@ -3,18 +3,27 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QCryptographicHash>
+#include <QFileInfo>
 #include <QDebug>
+#include <algorithm>
+#include <string.h>
 
 #include "scriptbase.h"
 #include "scriptstdstring.h"
 #include "scriptarray.h"
-#include "circuitwidget.h"
+#include "simulator.h"
 #include "mainwindow.h"
 #include "utils.h"
 #include "asdebugger.h"
 
 using namespace std;
 
+QHash<QString, ScriptBase::engine_t> ScriptBase::m_enginePool;
+QHash<QString, ScriptBase::module_t> ScriptBase::m_modulePool;
+QHash<QString, ScriptBase::include_t> ScriptBase::m_includeCache;
+ScriptBase* ScriptBase::m_compiling = nullptr;
+
 void ScriptBase::MessageCallback( const asSMessageInfo* msg )
 {
     QString type = " ERROR ";
@@ -30,55 +39,120 @@ void ScriptBase::MessageCallback( const asSMessageInfo* msg )
         if     ( type == " ERROR "  ) m_debugger->scriptError( msg->row );
         else if( type == " WARNING ") m_debugger->scriptWarning( msg->row );
     }
-    else CircuitWidget::self()->simDebugMessage( deb.remove("\n") );
+    else Simulator::self()->observer()->simDebugMessage( deb.remove("\n") );
     //qDebug() << msg->section << "line:" << msg->row << msg->col << type << msg->message;
 }
 
+void ScriptBase::sharedMessageCallback( const asSMessageInfo* msg, void* ) // Shared engines: send to instance compiling
+{
+    if( m_compiling ) m_compiling->MessageCallback( msg );
+}
+
 void print( string &msg )
 {
     qDebug() << msg.c_str();
 }
 
-ScriptBase::ScriptBase( QString name )
+ScriptBase::ScriptBase( QString name, QString engineKey )
           : eElement( name )
 {
     m_aEngine  = nullptr;
     m_asModule = nullptr;
     m_context  = nullptr;
     m_debugger = nullptr;
+    m_jit      = nullptr;
+    m_prepared = nullptr;
+
+    m_profiling = false;
+    m_profDepth = 0;
 
     m_scriptFile = "script";
+    m_engineKey  = engineKey;
+    m_newEngine  = false;
 
-    m_aEngine = asCreateScriptEngine();
-    if( m_aEngine == 0 ) { qDebug() << "Failed to create script engine."; return; }
+    if( m_engineKey.isEmpty() )            // Own engine
+    {
+        m_aEngine = createEngine();
+        if( m_aEngine == 0 ) return;
 
+        m_aEngine->SetMessageCallback(asMETHOD( ScriptBase, MessageCallback ), this, asCALL_THISCALL);
+#ifdef __x86_64__
+        m_jit = new asCJITCompiler( JIT_NO_SUSPEND | JIT_SYSCALL_NO_ERRORS );
+        m_aEngine->SetJITCompiler( m_jit );
+#endif
+        m_newEngine = true;
+    }
+    else if( m_enginePool.contains( m_engineKey ) ) // Shared engine already exists
+    {
+        m_enginePool[m_engineKey].users++;
+        m_aEngine = m_enginePool.value( m_engineKey ).engine;
+    }else{                                          // Create shared engine
+        m_aEngine = createEngine();
+        if( m_aEngine == 0 ) return;
+
+        m_aEngine->SetMessageCallback( asFUNCTION( sharedMessageCallback ), 0, asCALL_CDECL );
+        asCJITCompiler* jit = nullptr;
+#ifdef __x86_64__
+        jit = new asCJITCompiler( JIT_NO_SUSPEND | JIT_SYSCALL_NO_ERRORS );
+        m_aEngine->SetJITCompiler( jit );
+#endif
+        m_enginePool[m_engineKey] = { m_aEngine, jit, 1 };
+        m_newEngine = true;
+    }
     m_context = m_aEngine->CreateContext();
     if( m_context == 0 ) { qDebug() << "Failed to create the context."; return; }
+}
+ScriptBase::~ScriptBase()
+{
+    if( !m_aEngine ) return;
 
-    m_aEngine->SetEngineProperty( asEP_AUTO_GARBAGE_COLLECT   , false );
-    m_aEngine->SetEngineProperty( asEP_BUILD_WITHOUT_LINE_CUES, true );
+    releaseModule();
+    m_aEngine->GarbageCollect( asGC_FULL_CYCLE );  // Automatic garbage collection is disabled, doing it manually
 
-    //m_aEngine->SetMessageCallback( asFUNCTION( MessageCallback ), 0, asCALL_CDECL );
-    m_aEngine->SetMessageCallback(asMETHOD( ScriptBase, MessageCallback ), this, asCALL_THISCALL);
-    RegisterStdString( m_aEngine );
-    RegisterScriptArray( m_aEngine, true );
+    if( m_context ) m_context->Release();
+
+    if( !m_engineKey.isEmpty() )          // Shared engine: release when last user is gone
+    {
+        engine_t& pooled = m_enginePool[m_engineKey];
+        if( --pooled.users > 0 ) return;
+
+        m_jit = pooled.jit;
+        m_enginePool.remove( m_engineKey );
+    }
+    m_aEngine->ShutDownAndRelease();
+    if( m_jit ) delete m_jit;
+}
 
-    m_aEngine->RegisterGlobalFunction("void print(const string &in)", asFUNCTION(print), asCALL_CDECL);
+asIScriptEngine* ScriptBase::createEngine()
+{
+    asIScriptEngine* engine = asCreateScriptEngine();
+    if( engine == 0 ) { qDebug() << "Failed to create script engine."; return nullptr; }
 
-    m_jit = nullptr;
+    engine->SetEngineProperty( asEP_AUTO_GARBAGE_COLLECT   , false );
+    engine->SetEngineProperty( asEP_BUILD_WITHOUT_LINE_CUES, true );
 #ifdef __x86_64__
-    m_jit = new asCJITCompiler( JIT_NO_SUSPEND | JIT_SYSCALL_NO_ERRORS );
-    m_aEngine->SetEngineProperty( asEP_INCLUDE_JIT_INSTRUCTIONS, 1 );
-    m_aEngine->SetJITCompiler( m_jit );
+    engine->SetEngineProperty( asEP_INCLUDE_JIT_INSTRUCTIONS, 1 );
 #endif
+    RegisterStdString( engine );
+    RegisterScriptArray( engine, true );
+
+    engine->RegisterGlobalFunction("void print(const string &in)", asFUNCTION(print), asCALL_CDECL);
+
+    return engine;
 }
-ScriptBase::~ScriptBase()
+
+void ScriptBase::releaseModule()
 {
-    m_aEngine->GarbageCollect( asGC_FULL_CYCLE );  // Automatic garbage collection is disabled, doing it manually
+    if( m_moduleKey.isEmpty() ) return;
 
-    if( m_context ) m_context->Release();
-    if( m_aEngine ) m_aEngine->ShutDownAndRelease();
-    if( m_jit )     delete m_jit;
+    module_t& pooled = m_modulePool[m_moduleKey];
+    if( --pooled.users == 0 )
+    {
+        pooled.module->Discard();
+        m_modulePool.remove( m_moduleKey );
+    }
+    m_moduleKey.clear();
+    m_asModule = nullptr;
 }
 
 void ScriptBase::setScriptFile( QString scriptFile, bool )
@@ -97,20 +171,60 @@ int ScriptBase::compileScript()
 {
     if( !m_aEngine ) return -1;
 
+    releaseModule();
     m_aEngine->GarbageCollect( asGC_FULL_CYCLE );
-    m_asModule = m_aEngine->GetModule( 0, asGM_ALWAYS_CREATE );
 
-    int r = compileSection( m_scriptFile, m_script );
+    QList<section_t> sections;
+    int r = getSections( m_scriptFile, m_script, &sections );
     if( r < 0 ) return -1;
 
-    r = m_asModule->Build();
-    if( r < 0 ) { qDebug() << endl << m_elmId+" ScriptBase::compileScript Error"<< endl; return -1; }
+    QString moduleName;
+    if( !m_engineKey.isEmpty() )           // Shared engine: look for an already compiled module
+    {
+        QCryptographicHash hash( QCryptographicHash::Sha1 );
+        for( section_t section : sections )
+        {
+            hash.addData( section.file.toUtf8() );
+            hash.addData( section.text.toUtf8() );
+        }
+        moduleName = m_engineKey+"_"+hash.result().toHex();
+
+        if( m_modulePool.contains( moduleName ) )
+        {
+            m_modulePool[moduleName].users++;
+            m_moduleKey = moduleName;
+            m_asModule  = m_modulePool.value( moduleName ).module;
+            return 0;
+        }
+        m_compiling = this;
+    }
+    m_asModule = m_aEngine->GetModule( moduleName.toLocal8Bit().constData(), asGM_ALWAYS_CREATE );
 
+    for( section_t section : sections )
+    {
+        std::string script = section.text.toStdString();
+        r = m_asModule->AddScriptSection( section.file.toLocal8Bit().data(), &script[0], script.size() );
+        if( r < 0 ) { qDebug() << "\nScriptBase::compileScript: AddScriptSection() failed\n"; break; }
+    }
+    if( r >= 0 ) r = m_asModule->Build();
+    m_compiling = nullptr;
+
+    if( r < 0 ) {
+        qDebug() << endl << m_elmId+" ScriptBase::compileScript Error"<< endl;
+        if( !moduleName.isEmpty() ) m_asModule->Discard();
+        m_asModule = nullptr;
+        return -1;
+    }
+    if( !moduleName.isEmpty() )
+    {
+        m_modulePool[moduleName] = { m_asModule, 1 };
+        m_moduleKey = moduleName;
+    }
     //qDebug() << "\nScriptBase::compileScript: Build() Success\n";
     return 0;
 }
 
-int ScriptBase::compileSection( QString sriptFile, QString text )
+int ScriptBase::getSections( QString sriptFile, QString text, QList<section_t>* sections ) // Sections in build order: includes first
 {
     int ok = 0;
 
@@ -134,19 +248,33 @@ int ScriptBase::compileSection( QString sriptFile, QString text )
                 file = file.remove("<").split(">").first();
                 file.prepend( MainWindow::self()->getDataFilePath("scriptlib")+"/" );
             }
-            line = fileToString( file, "ScriptBase::compileScript" );
-            int r = compileSection( file, line );
+            line = includeText( file );
+            int r = getSections( file, line, sections );
             if( r < 0 ) ok = r;
             line.clear();
         }
         text.append( line+"\n");
     }
-    std::string script = text.toStdString();
+    sections->append( { sriptFile, text } );
+    return ok;
+}
 
-    int r = m_asModule->AddScriptSection( sriptFile.toLocal8Bit().data(), &script[0], script.size() );
-    if( r < 0 ) { qDebug() << "\nScriptBase::compileSection: AddScriptSection() failed\n"; return -1; }
+QString ScriptBase::includeText( QString file ) // Library files are read only once unless modified
+{
+    QFileInfo info( file );
+    if( !info.exists() ) return fileToString( file, "ScriptBase::compileScript" ); // Show error
 
-    return ok;
+    QDateTime modified = info.lastModified();
+    qint64    size     = info.size();
+
+    if( m_includeCache.contains( file ) )
+    {
+        include_t cached = m_includeCache.value( file );
+        if( cached.modified == modified && cached.size == size ) return cached.text;
+    }
+    QString text = fileToString( file, "ScriptBase::compileScript" );
+    m_includeCache[file] = { modified, size, text };
+    return text;
 }
 
 /*int ScriptBase::SaveBytecode(asIScriptEngine *engine, const char *outputFile)
@@ -181,6 +309,7 @@ int ScriptBase::compileSection( QString sriptFile, QString text )
 int ScriptBase::callFunction0( asIScriptFunction* func, asIScriptContext* context )
 {
     context->Prepare( func );
+    if( m_profiling ) return profExecute( func, context );
     return context->Execute();
 }
 
@@ -192,7 +321,8 @@ void ScriptBase::callFunction( asIScriptFunction* func )
 
 void ScriptBase::execute()
 {
-    m_status = m_context->Execute();
+    if( m_profiling ) m_status = profExecute( m_prepared, m_context );
+    else              m_status = m_context->Execute();
     if( m_status != asEXECUTION_FINISHED ) printError( m_context );
 }
 
@@ -214,3 +344,113 @@ void ScriptBase::printError( asIScriptContext* context ) // The execution didn't
     }
     else qDebug() << "The script ended for some unforeseen reason:" << m_status;
 }
+
+void ScriptBase::setProfiling( bool p ) // Module is rebuilt: script state is lost
+{
+    if( p == m_profiling ) return;
+    if( Simulator::self()->isRunning() ) Simulator::self()->observer()->simPowerOff();
+
+    m_profiling = p;
+    if( p && !m_profTimer.isValid() ) m_profTimer.start();
+
+    if( !m_aEngine || !m_engineKey.isEmpty() ) return; // Shared engine: other users need JIT
+
+    // Line callbacks need line cues, and JIT code never reaches them
+    m_aEngine->SetEngineProperty( asEP_BUILD_WITHOUT_LINE_CUES, !p );
+#ifdef __x86_64__
+    m_aEngine->SetJITCompiler( p ? nullptr : m_jit );
+#endif
+    if( m_asModule ) compileScript();
+}
+
+void ScriptBase::resetProfile()
+{
+    m_entryProf.clear();
+    m_stackProf.clear();
+}
+
+int ScriptBase::profExecute( asIScriptFunction* func, asIScriptContext* context )
+{
+    qint64 start = m_profTimer.nsecsElapsed();
+
+    if( m_profDepth++ )   // Nested call: only entry point time
+    {
+        int r = context->Execute();
+        prof_t& prof = m_entryProf[func];
+        prof.calls++;
+        prof.time += m_profTimer.nsecsElapsed()-start;
+        m_profDepth--;
+        return r;
+    }
+    m_stack = QByteArray( (const char*)&func, sizeof(func) );
+    m_sampleTime = start;
+    context->SetLineCallback( asMETHOD( ScriptBase, lineCallback ), this, asCALL_THISCALL );
+
+    int r = context->Execute();
+
+    context->ClearLineCallback();
+    qint64 end = m_profTimer.nsecsElapsed();
+    m_stackProf[m_stack] += end-m_sampleTime;
+
+    prof_t& prof = m_entryProf[func];
+    prof.calls++;
+    prof.time += end-start;
+    m_profDepth--;
+    return r;
+}
+
+void ScriptBase::lineCallback( asIScriptContext* context ) // Time since last sample goes to last stack
+{
+    qint64 now = m_profTimer.nsecsElapsed();
+    m_stackProf[m_stack] += now-m_sampleTime;
+    m_sampleTime = now;
+
+    m_stack.clear();
+    for( int i=context->GetCallstackSize()-1; i>=0; --i ) // Outermost first
+    {
+        asIScriptFunction* func = context->GetFunction( i );
+        if( func ) m_stack.append( (const char*)&func, sizeof(func) );
+}   }
+
+QString ScriptBase::profileReport()
+{
+    QString report = m_elmId+":\n";
+    report += "     Calls    Total ms   Average us  Entry\n";
+
+    QList<asIScriptFunction*> funcs = m_entryProf.keys();
+    std::sort( funcs.begin(), funcs.end(), [this]( asIScriptFunction* a, asIScriptFunction* b )
+                                          { return m_entryProf.value( a ).time > m_entryProf.value( b ).time; } );
+    for( asIScriptFunction* func : funcs )
+    {
+        prof_t prof = m_entryProf.value( func );
+        double total = prof.time/1e6;
+        double avg   = prof.calls ? prof.time/1e3/prof.calls : 0;
+        report += QString("%1 %2 %3  %4\n").arg( prof.calls, 10 )
+                                          .arg( total, 11, 'f', 3 )
+                                          .arg( avg, 12, 'f', 3 )
+                                          .arg( func->GetDeclaration() );
+    }
+    return report;
+}
+
+QStringList ScriptBase::foldedStacks()
+{
+    QStringList lines;
+    for( QByteArray stack : m_stackProf.keys() )
+    {
+        qint64 us = m_stackProf.value( stack )/1000;
+        if( us < 1 ) continue;
+
+        QString line = m_elmId;
+        line.replace(" ","_").replace(";","_");
+        const char* data = stack.constData();
+        for( int i=0; i+(int)sizeof(void*)<=stack.size(); i+=sizeof(void*) )
+        {
+            asIScriptFunction* func;
+            memcpy( &func, data+i, sizeof(func) );
+            line += ";"+QString( func->GetName() );
+        }
+        lines.append( line+" "+QString::number( us ) );
+    }
+    return lines;
+}
@@ -6,6 +6,10 @@
 #ifndef SCRIPTBASE_H
 #define SCRIPTBASE_H
 
+#include <QHash>
+#include <QDateTime>
+#include <QElapsedTimer>
+
 #include "angelscript.h"
 #include "as_jit.h"
 
@@ -14,16 +18,23 @@
 class asDebugger;
 class asCJITCompiler;
 
+// Instances created with the same engineKey share one engine (API must be
+// registered only once: if newEngine()) and those with the same script text
+// share the compiled module, so the script can't keep state between calls.
+
 class ScriptBase : public eElement
 {
     public:
-        ScriptBase( QString name );
+        ScriptBase( QString name, QString engineKey="" );
         ~ScriptBase();
 
         void MessageCallback( const asSMessageInfo* msg );
+ static void sharedMessageCallback( const asSMessageInfo* msg, void* );
 
         virtual int compileScript();
 
+        virtual bool unsavedState() override { return true; } // Script variables are not saved
+
         virtual void setScriptFile( QString scriptFile, bool compile=true );
         virtual void setScript( QString script );
 
@@ -32,15 +43,38 @@ class ScriptBase : public eElement
 
         void callFunction( asIScriptFunction* func );
         int callFunction0( asIScriptFunction* func, asIScriptContext* context );
-        inline void prepare( asIScriptFunction* func ) { m_context->Prepare( func ); }
+        inline void prepare( asIScriptFunction* func ) { m_context->Prepare( func ); m_prepared = func; }
         void execute();
         int getExeStatus() { return m_status; }
 
         void setDebugger( asDebugger* d ) { m_debugger = d; }
 
+        bool newEngine() { return m_newEngine; }
+
+        // Profiler: calls and time per entry point, time per call stack
+        // sampled at line callbacks. While profiling the module is built
+        // with line cues and without JIT, so simulation is stopped to rebuild.
+        bool profiling() { return m_profiling; }
+        void setProfiling( bool p );
+        void resetProfile();
+        QString profileReport();
+        QStringList foldedStacks(); // "entry;func;func weight(us)" for flame graphs
+
     protected:
+        struct section_t{
+            QString file;
+            QString text;
+        };
+
         void printError( asIScriptContext* context );
-        int compileSection( QString sriptFile, QString text );
+        int getSections( QString sriptFile, QString text, QList<section_t>* sections );
+        QString includeText( QString file );
+        void releaseModule();
+
+        asIScriptEngine* createEngine();
+
+        int profExecute( asIScriptFunction* func, asIScriptContext* context );
+        void lineCallback( asIScriptContext* context );
 
         int m_status;
 
@@ -54,5 +88,43 @@ class ScriptBase : public eElement
         asIScriptContext* m_context;
 
         asDebugger* m_debugger;
+
+        asIScriptFunction* m_prepared;
+
+        struct prof_t{
+            uint64_t calls;
+            qint64   time;  // Nanoseconds
+        };
+        bool m_profiling;
+        int  m_profDepth;
+        QElapsedTimer m_profTimer;
+        qint64 m_sampleTime;
+        QByteArray m_stack;                  // Current call stack: function pointers
+        QHash<asIScriptFunction*, prof_t> m_entryProf;
+        QHash<QByteArray, qint64> m_stackProf;
+
+        QString m_engineKey;   // Not empty if engine is shared
+        QString m_moduleKey;   // Not empty if module is shared
+        bool m_newEngine;
+
+    private:
+        struct engine_t{
+            asIScriptEngine* engine;
+            asCJITCompiler*  jit;
+            int users;
+        };
+        struct module_t{
+            asIScriptModule* module;
+            int users;
+        };
+        struct include_t{
+            QDateTime modified;
+            qint64    size;
+            QString   text;
+        };
+ static QHash<QString, engine_t>  m_enginePool;
+ static QHash<QString, module_t>  m_modulePool;
+ static QHash<QString, include_t> m_includeCache; // Included files by path
+ static ScriptBase* m_compiling; // Instance compiling in a shared engine
 };
 #endif
@@ -17,6 +17,8 @@ ScriptModule::ScriptModule( eMcu* mcu, QString name )
     m_configureC   = NULL;
     m_callBackDoub = NULL;
     m_callBack     = NULL;
+
+    mcu->addScript( this );
 }
 ScriptModule::~ScriptModule()
 {
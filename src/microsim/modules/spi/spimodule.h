@@ -25,6 +25,7 @@ class SpiModule : public eClockedDevice
         virtual void initialize() override;
         virtual void stamp() override;
         virtual void runEvent() override;
+        virtual bool unsavedState() override { return true; }
         virtual void voltChanged() override;
 
         virtual void setMode( spiMode_t mode );
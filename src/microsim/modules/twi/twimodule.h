@@ -37,6 +37,7 @@ class TwiModule : public eClockedDevice
         virtual void initialize() override;
         virtual void stamp() override;
         virtual void runEvent() override;
+        virtual bool unsavedState() override { return true; }
         virtual void voltChanged() override;
 
         int cCode() { return m_cCode; }
@@ -10,7 +10,6 @@
 #include "usartrx.h"
 #include "e_mcu.h"
 #include "mcuinterrupts.h"
-#include "circuitwidget.h"
 #include "serialmon.h"
 #include "datautils.h"
 #include "iopin.h"
@@ -84,10 +83,10 @@ void UsartModule::byteReceived( uint8_t data )
     if( m_monitor ) m_monitor->printIn( data );
 }
 
-void UsartModule::openMonitor( QString id, int num, bool send )
+void UsartModule::openMonitor( QWidget* parent, QString id, int num, bool send )
 {
     if( !m_monitor )
-        m_monitor = new SerialMonitor( CircuitWidget::self(), this, send );
+        m_monitor = new SerialMonitor( parent, this, send );
 
     if( num > 0 ) id.append(" - Uart"+QString::number(num) );
     m_monitor->setWindowTitle( id );
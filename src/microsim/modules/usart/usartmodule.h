@@ -33,6 +33,7 @@ class UartTx;
 class UartRx;
 class UartSync;
 class SerialMonitor;
+class QWidget;
 
 class UsartModule
 {
@@ -57,7 +58,7 @@ class UsartModule
         virtual void byteReceived( uint8_t data );
         virtual void setRxFlags( uint16_t frame ){;}
 
-        void openMonitor( QString id, int num=0, bool send=false );
+        void openMonitor( QWidget* parent, QString id, int num=0, bool send=false );
         void setMonitorTittle( QString t );
         virtual void monitorClosed();
 
@@ -132,6 +133,7 @@ class UartTR : public McuModule, public eElement
         };
 
         virtual void initialize() override;
+        virtual bool unsavedState() override { return true; }
 
         virtual void enable( uint8_t ){;}
         virtual uint8_t getData() { return  m_data; }
@@ -9,6 +9,7 @@
 
 #include "circmatrix.h"
 #include "simulator.h"
+#include "simtrace.h"
 
 CircMatrix* CircMatrix::m_pSelf = 0l;
 
@@ -117,7 +118,10 @@ void CircMatrix::analyze()
 
 bool CircMatrix::solveMatrix()
 {
+    TRACE_SPAN("solveMatrix");
     bool ok = true;
+    SimProfiler* profiler = Simulator::self()->profiler();
+
     for( int i=0; i<m_bList.size(); ++i )
     {
         if( !m_admitChanged[i] && !m_currChanged[i] ) continue;
@@ -125,8 +129,17 @@ bool CircMatrix::solveMatrix()
         m_eNodeActive = &(m_eNodeActList[i]);
         int n = m_eNodeActive->size();
 
-        if( m_admitChanged[i] ) factorMatrix( n, i );
-        if( !luSolve( n, i ) ) ok = false;
+        if( profiler )
+        {
+            uint64_t t0 = profiler->time();
+            if( m_admitChanged[i] ) factorMatrix( n, i );
+            uint64_t t1 = profiler->time();
+            if( !luSolve( n, i ) ) ok = false;
+            profiler->matrixSolved( i, n, m_admitChanged[i], t1-t0, profiler->time()-t1 );
+        }else{
+            if( m_admitChanged[i] ) factorMatrix( n, i );
+            if( !luSolve( n, i ) ) ok = false;
+        }
 
         m_currChanged[i]  = false;
         m_admitChanged[i] = false;
@@ -25,6 +25,7 @@ eElement::~eElement()
     if( !Simulator::self() ) return;
     Simulator::self()->remFromElementList( this );
     Simulator::self()->cancelEvents( this );
+    Simulator::self()->remPeriodic( this );
 }
 
 void eElement::setNumEpins( int n )
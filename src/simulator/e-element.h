@@ -10,6 +10,7 @@
 #include <QString>
 
 class ePin;
+class QDataStream;
 
 class eElement
 {
@@ -23,6 +24,11 @@ class eElement
         virtual void runEvent(){;}
         virtual void voltChanged(){;}
 
+        // Checkpoint: save/restore internal state while simulation is paused
+        virtual void saveState( QDataStream& ){;}
+        virtual void loadState( QDataStream& ){;}
+        virtual bool unsavedState() { return false; } // Has internal state not included in checkpoints
+
         virtual void setNumEpins( int n );
 
         virtual ePin* getEpin( int num );
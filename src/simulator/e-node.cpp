@@ -37,7 +37,7 @@ eNode::~eNode()
 
 void eNode::initialize()
 {
-    m_voltChanged  = true; // Used for wire animation
+    m_voltChanged  = false; // Used for wire animation
     //m_switched     = false;
     m_single       = false;
     m_changed      = false;
@@ -45,6 +45,7 @@ void eNode::initialize()
     m_admitChanged = false;
     m_nodeGroup = -1;
     nextCH = NULL;
+    nextAnim = NULL;
     m_volt = 0;
 
     clearElmList( m_voltChEl );
@@ -255,9 +256,13 @@ void  eNode::setVolt( double v )
 {
     if( m_volt == v ) return;
 
-    m_voltChanged = true; // Used for wire animation
     m_volt = v;
 
+    if( !m_voltChanged ){ // Used for wire animation
+        m_voltChanged = true;
+        Simulator::self()->addToAnimNodes( this );
+    }
+
     CallBackElement* linked = m_voltChEl; // VoltChaneg callback
     while( linked )
     {
@@ -342,16 +347,13 @@ void eNode::addToNoLinList( eElement* el )
     //qDebug() <<m_id<< el->getId();
 }
 
-void eNode::updateConnectors()
+void eNode::updateConnectors( const QRectF& area ) // Only Connectors in area (if not null)
 {
-    if( !m_voltChanged ) return;
-    m_voltChanged = false;
-
     for( ePin* epin : m_ePinList ){
         Pin* pin = epin->getPin();
         if( pin && pin->isVisible() ){
             Connector* conn = pin->connector();
-            if( conn ) conn->updateLines();
+            if( conn ) conn->updateLines( area );
         }
     }
 }
@@ -7,12 +7,15 @@
 #define ENODE_H
 
 #include<QHash>
+#include<QRectF>
 
 class ePin;
 class eElement;
 
 class eNode
 {
+    friend class Simulator;
+
     public:
         eNode( QString id );
         ~eNode();
@@ -54,13 +57,14 @@ class eNode
         void setSingle( bool single ) { m_single = single; } // This eNode can calculate it's own Volt
         //void setSwitched( bool switched ){ m_switched = switched; } // This eNode has switches attached
 
-        void updateConnectors();
+        void updateConnectors( const QRectF& area=QRectF() );
 
         QList<ePin*> getEpins() { return m_ePinList; }
 
         QList<int> getConnections();
 
         eNode* nextCH;
+        eNode* nextAnim;
 
     private:
         class Connection
@@ -114,7 +118,7 @@ class eNode
 
         bool m_currChanged;
         bool m_admitChanged;
-        bool m_voltChanged;
+        bool m_voltChanged; // In Simulator wire animation list
         bool m_changed;
         bool m_single;
         //bool m_switched;
@@ -0,0 +1,55 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <algorithm>
+
+#include "e-periodic.h"
+#include "simulator.h"
+
+ePeriodic::ePeriodic( double period )
+         : eElement( "periodic" )
+{
+    m_period    = period;
+    m_remainder = 0;
+    m_count     = 0;
+    m_running   = false;
+}
+ePeriodic::~ePeriodic(){}
+
+void ePeriodic::runEvent()
+{
+    SimProfiler* profiler = Simulator::self()->profiler();
+
+    m_running = true;
+    for( uint i=0; i<m_members.size(); ++i ) // Members can be removed while running
+    {
+        if( !m_members[i] ) continue;
+        if( profiler ) profiler->runEvent( m_members[i] );
+        else           m_members[i]->runEvent();
+    }
+    m_running = false;
+
+    if( m_count < m_members.size() )
+        m_members.erase( std::remove( m_members.begin(), m_members.end(), nullptr ), m_members.end() );
+
+    if( m_count == 0 ) return;
+
+    m_remainder += m_period;
+    uint64_t step = m_remainder;
+    m_remainder -= step;
+    Simulator::self()->addEvent( step, this );
+}
+
+bool ePeriodic::remMember( eElement* el )
+{
+    for( uint i=0; i<m_members.size(); ++i )
+    {
+        if( m_members[i] != el ) continue;
+        m_members[i] = nullptr;
+        m_count--;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,43 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef EPERIODIC_H
+#define EPERIODIC_H
+
+#include "e-element.h"
+
+// Group of elements firing with the same period and phase.
+// Only the group is in Simulator event list: one insertion per period
+// for all members, and members don't need to reschedule themselves.
+
+class ePeriodic : public eElement
+{
+    public:
+        ePeriodic( double period );
+        ~ePeriodic();
+
+        virtual void runEvent() override;
+
+        double period() { return m_period; }
+
+        double remainder() { return m_remainder; }
+        void setRemainder( double r ) { m_remainder = r; }
+
+        std::vector<eElement*>* members() { return &m_members; }
+
+        void addMember( eElement* el ) { m_members.push_back( el ); m_count++; }
+        bool remMember( eElement* el );
+        bool isEmpty() { return m_count == 0; }
+        bool running() { return m_running; }
+
+    private:
+        double m_period;    // Picoseconds, can be fractional
+        double m_remainder;
+
+        uint m_count;
+        bool m_running;   // In runEvent(): can't be deleted
+        std::vector<eElement*> m_members; // Removed members are nullptr until next run
+};
+#endif
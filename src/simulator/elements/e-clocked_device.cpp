@@ -4,7 +4,6 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include "e-clocked_device.h"
-#include "circuitwidget.h"
 #include "simulator.h"
 #include "circuit.h"
 #include "iopin.h"
@@ -68,7 +67,7 @@ void eClockedDevice::updateClock()
 
 void eClockedDevice::setTrigger( trigger_t trigger )
 {
-    if( Simulator::self()->isRunning() ) CircuitWidget::self()->powerCircOff();
+    if( Simulator::self()->isRunning() ) Simulator::self()->observer()->simPowerOff();
 
     m_trigger = trigger;
     m_clock = false;
@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <QDataStream>
+
 #include "e-reactive.h"
 #include "e-pin.h"
 #include "e-node.h"
@@ -67,6 +69,20 @@ void eReactive::runEvent()
     else m_running = false;
 }
 
+void eReactive::saveState( QDataStream& out )
+{
+    out << m_volt << m_curSource << m_running;
+}
+
+void eReactive::loadState( QDataStream& in )
+{
+    in >> m_volt >> m_curSource >> m_running;
+
+    if( !m_ePin[0]->isConnected() || !m_ePin[1]->isConnected() ) return;
+    m_ePin[0]->stampCurrent( m_curSource );
+    m_ePin[1]->stampCurrent(-m_curSource );
+}
+
 void eReactive::updtReactStep()
 {
     if( m_reacStep ) m_timeStep = m_reacStep;
@@ -18,6 +18,9 @@ class eReactive : public eResistor
         virtual void voltChanged() override;
         virtual void runEvent() override;
 
+        virtual void saveState( QDataStream& out ) override;
+        virtual void loadState( QDataStream& in ) override;
+
         double initVolt() { return m_InitVolt; }
         void setInitVolt( double v ) { m_InitVolt = v; }
 
@@ -0,0 +1,41 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef SIMOBSERVER_H
+#define SIMOBSERVER_H
+
+#include <QString>
+#include <QRectF>
+
+// Simulator reports to the application through this interface,
+// so the simulation engine doesn't depend on any widget.
+// Default implementation does nothing (headless runs).
+// First step to a GUI free engine. Still pending before src/simulator
+// can build as a QtCore only library:
+// - Simulator gets pins from Circuit pin map to build nodes, eNode uses Pin/Connector.
+// - ePin renames pins in Circuit, Simulator and eClockedDevice call Circuit::update().
+// - eDiode reads models file path from MainWindow.
+// - Elements are QGraphicsItems (Component, Pin).
+
+class SimObserver
+{
+    public:
+        virtual ~SimObserver(){;}
+
+        virtual void simMessage( QString, int ){;}          // msg, type: 0 Running, 1 Stopped/Warning, 2 Error
+        virtual void simError( QString ){;}                 // Simulation must be stopped
+        virtual void simDebugMessage( QString ){;}          // Output from simulated devices (scripts, etc)
+        virtual void simPowerOff(){;}                       // Element needs Simulation stopped to change
+
+        virtual void simFrame(){;}                          // Each frame, Simulation thread is stopped
+        virtual void simRate( double, double, double, int ){;} // speed, simLoad, guiLoad, fps
+        virtual void simTime( uint64_t ){;}
+        virtual void simTargetSpeed( double ){;}
+
+        virtual bool simAnimate() { return false; }         // Update wire animation
+        virtual QRectF simViewArea() { return QRectF(); }   // Visible area for animation, null = all
+};
+
+#endif
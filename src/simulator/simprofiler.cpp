@@ -0,0 +1,164 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+
+#include "simprofiler.h"
+#include "component.h"
+
+SimProfiler::SimProfiler()
+{
+    m_timer.start();
+    m_resetReq = false;
+    clear();
+    m_snapCounters = m_counters;
+}
+SimProfiler::~SimProfiler(){}
+
+void SimProfiler::clear()
+{
+    m_elements.clear();
+    m_groups.clear();
+    m_counters = { 0, 0, 0, 0, 0 };
+    m_childNs   = 0;
+    m_startTime = 0;
+}
+
+void SimProfiler::commit( uint64_t circTime )
+{
+    if( m_resetReq ) { clear(); m_startTime = circTime; m_resetReq = false; }
+    if( circTime < m_startTime ) m_startTime = 0;          // Simulation restarted
+    m_counters.simTime = circTime-m_startTime;
+
+    QMutexLocker locker( &m_mutex );
+    m_snapElements = m_elements; // Implicitly shared: deep copy at next change
+    m_snapGroups   = m_groups;
+    m_snapCounters = m_counters;
+}
+
+SimProfiler::elmStat_t* SimProfiler::stat( eElement* el )
+{
+    auto it = m_elements.find( el );
+    if( it != m_elements.end() ) return &it.value();
+
+    elmStat_t s = { el->getId(), "", 1, 0, 0, 0, 0, 0, 0 };
+    if( Component* comp = dynamic_cast<Component*>( el ) ) s.type = comp->itemType();
+    else s.type = s.id.split("-").first(); // Internal elements: "Type-N-name"
+
+    return &m_elements.insert( el, s ).value();
+}
+
+void SimProfiler::stamp( eElement* el )
+{
+    uint64_t childNs = m_childNs; m_childNs = 0;
+    uint64_t t0 = time();
+    el->stamp();
+    uint64_t t = time()-t0;
+    elmStat_t* s = stat( el );
+    s->stamps++;
+    s->stampNs += t-m_childNs;
+    m_childNs = childNs+t;
+}
+
+void SimProfiler::matrixSolved( int group, int size, bool factored, uint64_t factorNs, uint64_t solveNs )
+{
+    if( group >= m_groups.size() ) m_groups.resize( group+1 );
+    groupStat_t& g = m_groups[group];
+    g.size = size;
+    if( factored ) { g.factors++; g.factorNs += factorNs; }
+    g.solves++;
+    g.solveNs += solveNs;
+}
+
+QList<SimProfiler::elmStat_t> SimProfiler::elements()
+{
+    QMutexLocker locker( &m_mutex );
+    return m_snapElements.values();
+}
+
+QList<SimProfiler::elmStat_t> SimProfiler::types()
+{
+    QHash<QString, elmStat_t> types;
+    for( const elmStat_t& s : elements() )
+    {
+        elmStat_t& t = types[s.type];  // Value initialized: counters = 0
+        t.type = s.type;
+        t.count++;
+        t.events      += s.events;      t.eventNs += s.eventNs;
+        t.voltChanges += s.voltChanges; t.voltNs  += s.voltNs;
+        t.stamps      += s.stamps;      t.stampNs += s.stampNs;
+    }
+    return types.values();
+}
+
+QVector<SimProfiler::groupStat_t> SimProfiler::groups()
+{
+    QMutexLocker locker( &m_mutex );
+    return m_snapGroups;
+}
+
+SimProfiler::counters_t SimProfiler::counters()
+{
+    QMutexLocker locker( &m_mutex );
+    return m_snapCounters;
+}
+
+bool SimProfiler::dump( QString fileName )
+{
+    QFile file( fileName );
+    if( !file.open( QFile::WriteOnly | QFile::Text | QFile::Truncate ) )
+    {
+        qDebug() << "SimProfiler::dump Error: Could not write:" << fileName;
+        return false;
+    }
+    QTextStream out( &file );
+
+    QList<elmStat_t> elmList  = elements();
+    QList<elmStat_t> typeList = types();
+    counters_t counters = this->counters();
+
+    auto byTime = []( const elmStat_t& a, const elmStat_t& b ){
+        return (a.eventNs+a.voltNs+a.stampNs) > (b.eventNs+b.voltNs+b.stampNs); };
+
+    QString header = "events\tevent_ms\tvoltChanged\tvoltChanged_ms\tstamps\tstamp_ms\ttotal_ms\n";
+    auto row = []( const elmStat_t& s ){
+        return QString("%1\t%2\t%3\t%4\t%5\t%6\t%7\n")
+              .arg( s.events ).arg( s.eventNs/1e6 )
+              .arg( s.voltChanges ).arg( s.voltNs/1e6 )
+              .arg( s.stamps ).arg( s.stampNs/1e6 )
+              .arg( (s.eventNs+s.voltNs+s.stampNs)/1e6 ); };
+
+    out << "# SimulIDE profile\n";
+    out << "simulated_ps\t"     << counters.simTime      << "\n";
+    out << "events_scheduled\t" << counters.scheduled    << "\n";
+    out << "events_cancelled\t" << counters.cancelled    << "\n";
+    out << "nonlinear_iter\t"   << counters.nlIterations << "\n";
+    out << "node_stamps\t"      << counters.nodeStamps   << "\n";
+
+    std::sort( typeList.begin(), typeList.end(), byTime );
+    out << "\n# By type\ntype\telements\t" << header;
+    for( const elmStat_t& t : typeList )
+        out << t.type << "\t" << t.count << "\t" << row( t );
+
+    std::sort( elmList.begin(), elmList.end(), byTime );
+    out << "\n# By element\nelement\ttype\t" << header;
+    for( const elmStat_t& s : elmList )
+        out << s.id << "\t" << s.type << "\t" << row( s );
+
+    QVector<groupStat_t> groups = this->groups();
+    out << "\n# Matrix groups\ngroup\tnodes\tfactorizations\tfactor_ms\tsolves\tsolve_ms\n";
+    for( int i=0; i<groups.size(); ++i )
+    {
+        const groupStat_t& g = groups.at(i);
+        if( !g.solves ) continue;
+        out << i << "\t" << g.size << "\t" << g.factors << "\t" << g.factorNs/1e6
+                 << "\t" << g.solves << "\t" << g.solveNs/1e6 << "\n";
+    }
+    file.close();
+    return true;
+}
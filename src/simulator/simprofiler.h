@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef SIMPROFILER_H
+#define SIMPROFILER_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QHash>
+#include <QVector>
+
+#include "e-element.h"
+
+// Opt-in Simulator profiler: time and calls of runEvent(), voltChanged()
+// and stamp() per eElement, event list and matrix activity.
+// Times are exclusive: time spent in nested calls is not counted twice.
+// Data is collected in the Simulation thread and copied to a snapshot
+// with commit() while that thread is stopped, GUI reads the snapshot.
+
+class SimProfiler
+{
+    public:
+        SimProfiler();
+        ~SimProfiler();
+
+        struct elmStat_t{
+            QString  id;
+            QString  type;
+            uint     count;        // Elements in aggregated stats
+            uint64_t events;
+            uint64_t eventNs;
+            uint64_t voltChanges;
+            uint64_t voltNs;
+            uint64_t stamps;
+            uint64_t stampNs;
+        };
+        struct groupStat_t{ // Matrix node group
+            int      size;
+            uint64_t factors;
+            uint64_t factorNs;
+            uint64_t solves;
+            uint64_t solveNs;
+        };
+        struct counters_t{
+            uint64_t scheduled;    // Events added
+            uint64_t cancelled;
+            uint64_t nlIterations; // Non linear iterations
+            uint64_t nodeStamps;   // eNode::stampMatrix() calls
+            uint64_t simTime;      // Simulated ps since reset
+        };
+
+        void reset() { m_resetReq = true; } // Applied at next commit()
+        void commit( uint64_t circTime );   // Only while Simulation thread is stopped
+
+        inline uint64_t time() { return m_timer.nsecsElapsed(); }
+
+        inline void runEvent( eElement* el )
+        {
+            uint64_t childNs = m_childNs; m_childNs = 0;
+            uint64_t t0 = time();
+            el->runEvent();
+            uint64_t t = time()-t0;
+            elmStat_t* s = stat( el );
+            s->events++;
+            s->eventNs += t-m_childNs;
+            m_childNs = childNs+t;
+        }
+        inline void voltChanged( eElement* el )
+        {
+            uint64_t childNs = m_childNs; m_childNs = 0;
+            uint64_t t0 = time();
+            el->voltChanged();
+            uint64_t t = time()-t0;
+            elmStat_t* s = stat( el );
+            s->voltChanges++;
+            s->voltNs += t-m_childNs;
+            m_childNs = childNs+t;
+        }
+        void stamp( eElement* el );
+
+        inline void eventAdded()     { m_counters.scheduled++; }
+        inline void eventCancelled() { m_counters.cancelled++; }
+        inline void nlIteration()    { m_counters.nlIterations++; }
+        inline void nodeStamped()    { m_counters.nodeStamps++; }
+        void matrixSolved( int group, int size, bool factored, uint64_t factorNs, uint64_t solveNs );
+
+        // Snapshot access, any thread
+        QList<elmStat_t>     elements();
+        QList<elmStat_t>     types();   // Aggregated by type
+        QVector<groupStat_t> groups();
+        counters_t           counters();
+
+        bool dump( QString fileName );
+
+    private:
+        elmStat_t* stat( eElement* el );
+        void clear();
+
+        QElapsedTimer m_timer;
+        uint64_t m_childNs; // Time in nested calls
+        uint64_t m_startTime;
+        bool     m_resetReq;
+
+        QHash<eElement*, elmStat_t> m_elements;
+        QVector<groupStat_t>        m_groups;
+        counters_t                  m_counters;
+
+        QMutex m_mutex;     // Protects snapshot
+        QHash<eElement*, elmStat_t> m_snapElements;
+        QVector<groupStat_t>        m_snapGroups;
+        counters_t                  m_snapCounters;
+};
+
+#endif
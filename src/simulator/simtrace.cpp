@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QMutex>
+#include <QThread>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <vector>
+
+#include "simtrace.h"
+
+#define TRACE_BUFFER_SIZE (1<<18) // Events per thread
+
+struct traceEvent_t{
+    const char* name;
+    uint64_t    time;  // ns
+    double      value;
+    char        phase; // 'B' begin, 'E' end, 'C' counter
+};
+
+struct traceBuffer_t{
+    int  tid;
+    bool gui;
+    uint64_t head;     // Events written, next position = head % size
+    std::vector<traceEvent_t> events;
+};
+
+std::atomic<bool> SimTrace::m_enabled( false );
+
+static QMutex s_mutex;                          // Protects s_buffers
+static std::vector<traceBuffer_t*> s_buffers;   // Never deleted: threads may still hold them
+static QElapsedTimer s_timer;
+static thread_local traceBuffer_t* t_buffer = nullptr;
+
+static inline void record( const char* name, char phase, double value )
+{
+    if( !t_buffer ) // First event in this thread
+    {
+        QMutexLocker locker( &s_mutex );
+        t_buffer = new traceBuffer_t;
+        t_buffer->tid  = s_buffers.size()+1;
+        t_buffer->gui  = QThread::currentThread() == QCoreApplication::instance()->thread();
+        t_buffer->head = 0;
+        t_buffer->events.resize( TRACE_BUFFER_SIZE );
+        s_buffers.push_back( t_buffer );
+    }
+    traceEvent_t& e = t_buffer->events[t_buffer->head % TRACE_BUFFER_SIZE];
+    e.name  = name;
+    e.time  = s_timer.nsecsElapsed();
+    e.value = value;
+    e.phase = phase;
+    t_buffer->head++;
+}
+
+void SimTrace::setEnabled( bool e )
+{
+    if( e && !s_timer.isValid() ) s_timer.start();
+    m_enabled.store( e, std::memory_order_relaxed );
+}
+
+void SimTrace::begin( const char* name ) { record( name, 'B', 0 ); }
+void SimTrace::end( const char* name )   { record( name, 'E', 0 ); }
+
+void SimTrace::counter( const char* name, double value )
+{
+    if( enabled() ) record( name, 'C', value );
+}
+
+void SimTrace::clear()
+{
+    QMutexLocker locker( &s_mutex );
+    for( traceBuffer_t* buffer : s_buffers ) buffer->head = 0;
+}
+
+bool SimTrace::save( QString fileName )
+{
+    QFile file( fileName );
+    if( !file.open( QFile::WriteOnly | QFile::Text | QFile::Truncate ) )
+    {
+        qDebug() << "SimTrace::save Error: Could not write:" << fileName;
+        return false;
+    }
+    QTextStream out( &file );
+    qint64 pid = QCoreApplication::applicationPid();
+
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+
+    QMutexLocker locker( &s_mutex );
+    for( traceBuffer_t* buffer : s_buffers )
+    {
+        if( !first ) out << ",\n";
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":\"" << (buffer->gui ? "GUI" : "Simulation") << " " << buffer->tid << "\"}}";
+
+        uint64_t head  = buffer->head;
+        uint64_t start = (head > TRACE_BUFFER_SIZE) ? head-TRACE_BUFFER_SIZE : 0;
+        for( uint64_t i=start; i<head; ++i )
+        {
+            const traceEvent_t& e = buffer->events[i % TRACE_BUFFER_SIZE];
+            out << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"" << e.phase
+                << "\",\"ts\":" << QString::number( e.time/1000.0, 'f', 3 )
+                << ",\"pid\":" << pid << ",\"tid\":" << buffer->tid;
+            if( e.phase == 'C' ) out << ",\"args\":{\"value\":" << e.value << "}";
+            out << "}";
+    }   }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    file.close();
+    return true;
+}
@@ -0,0 +1,49 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#ifndef SIMTRACE_H
+#define SIMTRACE_H
+
+#include <atomic>
+#include <QString>
+
+// Timeline of Simulator activity exported as Chrome trace-event JSON
+// (open in Perfetto or chrome://tracing).
+// Each thread records begin/end spans and counters in its own ring buffer,
+// oldest events are overwritten when full. Disabled by default: while
+// disabled a span costs one relaxed atomic load.
+
+class SimTrace
+{
+    public:
+        static bool enabled() { return m_enabled.load( std::memory_order_relaxed ); }
+        static void setEnabled( bool e );
+
+        static void begin( const char* name );  // name must be a string literal
+        static void end( const char* name );
+        static void counter( const char* name, double value );
+
+        // Call from GUI thread after Simulator::waitCircuit(): Simulation thread can't write meanwhile
+        static void clear();
+        static bool save( QString fileName );
+
+    private:
+        static std::atomic<bool> m_enabled;
+};
+
+class TraceSpan // Records a span from constructor to destructor
+{
+    public:
+        TraceSpan( const char* name ) : m_name( SimTrace::enabled() ? name : nullptr )
+        { if( m_name ) SimTrace::begin( m_name ); }
+        ~TraceSpan() { if( m_name ) SimTrace::end( m_name ); }
+
+    private:
+        const char* m_name;
+};
+
+#define TRACE_SPAN( name ) TraceSpan traceSpan( name )
+
+#endif
@@ -5,18 +5,17 @@
 
 #include <qtconcurrentrun.h>
 #include <QHash>
+#include <QFile>
+#include <QDataStream>
 #include <math.h>
 
 #include "simulator.h"
-#include "editorwindow.h"
+#include "simtrace.h"
 #include "circuit.h"
 #include "updatable.h"
-#include "outpaneltext.h"
-#include "mainwindow.h"
-#include "infowidget.h"
-#include "circuitwidget.h"
 #include "circmatrix.h"
 #include "e-element.h"
+#include "e-periodic.h"
 #include "socket.h"
 
 Simulator* Simulator::m_pSelf = nullptr;
@@ -27,6 +26,8 @@ Simulator::Simulator( QObject* parent )
     m_pSelf = this;
 
     m_matrix = new CircMatrix();
+    m_observer = &m_noObserver;
+    m_profiler = nullptr;
 
     m_fps = 20;
     m_timerId   = 0;
@@ -37,6 +38,8 @@ Simulator::Simulator( QObject* parent )
     m_reactStep = 1e6;
     m_maxNlstp  = 100000;
     m_slopeSteps = 0;
+    m_collapseSlopes = false;
+    m_animBudget = 10*1e6; // 10 ms
 
     m_errors[0] = "";
     //m_errors[1] = "Could not solve Matrix";
@@ -45,10 +48,10 @@ Simulator::Simulator( QObject* parent )
 
     m_warnings[1] = "NonLinear Not Converging";
     m_warnings[2] = "Probably Circuit Error";  // Warning if matrix diagonal element = 0.
+    m_warnings[3] = "Deep Capture disabled: can't create capture file";
     m_warnings[100] = "AVR crashed !!!";
 
     resetSim();
-    CircuitWidget::self()->setMsg( " "+tr("Stopped")+" ", 1 );
 
     m_RefTimer.start();
 }
@@ -61,6 +64,7 @@ Simulator::~Simulator()
 inline void Simulator::solveMatrix()
 {
     while( m_changedNode ){
+        if( m_profiler ) m_profiler->nodeStamped();
         m_changedNode->stampMatrix();
         m_changedNode = m_changedNode->nextCH;
     }
@@ -74,6 +78,7 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
     e->accept();
 
     if( m_state == SIM_WAITING ) return;
+    TRACE_SPAN("timerEvent");
 
     uint64_t currentTime = m_RefTimer.nsecsElapsed();
     double fps = 1e9/(currentTime-m_timerTime);
@@ -82,18 +87,17 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
 
     if( m_error )
     {
-        CircuitWidget::self()->powerCircOff();
-        CircuitWidget::self()->setError( m_errors.value( m_error ) );
+        m_observer->simError( m_errors.value( m_error ) );
         return;
     }
     else if( m_warning > 0 )
     {
         int type = (m_warning < 100)? 1:2;
-        CircuitWidget::self()->setMsg( m_warnings.value( m_warning), type );
+        m_observer->simMessage( m_warnings.value( m_warning), type );
         m_warning = -10;
     }
     else if( m_warning < 0 )
-    { if( ++m_warning == 0 ) CircuitWidget::self()->setMsg( " "+tr("Running")+" ", 0 ); }
+    { if( ++m_warning == 0 ) m_observer->simMessage( " "+tr("Running")+" ", 0 ); }
 
     if( !m_CircuitFuture.isFinished() ) // Stop remaining parallel thread
     {
@@ -102,30 +106,32 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
         m_CircuitFuture.waitForFinished();
         m_state = state;
     }
+    if( m_profiler ) m_profiler->commit( m_circTime );
 
     for( Updatable* el : m_updateList ) el->updateStep();
-    EditorWindow::self()->outPane()->updateStep(); // OutPanel in Editor can be created before this simulator.
+    m_observer->simFrame();
 
     // Calculate Simulation Load
     double timer_ns = m_timerTick_ms*1e6;
     uint64_t simLoop = 0;
     if( m_loopTime > m_refTime ) simLoop = m_loopTime-m_refTime;
     m_simLoad = (m_simLoad+100*simLoop/timer_ns)/2;
+    SimTrace::counter("simLoad", m_simLoad );
 
     // Get Simulation times
     m_simPsPF = m_circTime-m_tStep;
     m_tStep   = m_circTime;
 
+    bool animate = m_observer->simAnimate() && (m_timerTime-m_updtTime) >= 2e8; // Animate at 5 FPS
+    if( animate ) takeAnimNodes(); // Must be done while runCircuit thread is stopped
+
     if( m_state == SIM_RUNNING ) // Run Circuit in a parallel thread
         m_CircuitFuture = QtConcurrent::run( this, &Simulator::runCircuit );
 
-    if( Circuit::self()->animate() ) // Moved here to be in parallel with runCircuit thread
+    if( animate ) // Moved here to be in parallel with runCircuit thread
     {
-        if( (m_timerTime-m_updtTime) >= 2e8 ){ // Animate at 5 FPS
-            //Circuit::self()->updateConnectors();
-            for( eNode* node : m_eNodeList) node->updateConnectors();
-            m_updtTime = m_timerTime;
-        }
+        updateAnimNodes();
+        m_updtTime = m_timerTime;
     }
     // Calculate Real Simulation Speed
     m_refTime  = m_RefTimer.nsecsElapsed();
@@ -136,17 +142,47 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
         m_guiTime = 0;
 
         m_realSpeed = (m_tStep-m_lastStep)*10.0/deltaRefTime;
-        InfoWidget::self()->setRate( m_realSpeed, m_simLoad, guiLoad, m_realFPS+0.5 );
+        m_observer->simRate( m_realSpeed, m_simLoad, guiLoad, m_realFPS+0.5 );
         m_lastStep = m_tStep;
         m_lastRefT = m_refTime;
     }
-    InfoWidget::self()->setCircTime( m_tStep );
+    m_observer->simTime( m_tStep );
 
     m_guiTime += m_RefTimer.nsecsElapsed()-m_timerTime; // Time in this function
 }
 
+void Simulator::takeAnimNodes() // Get nodes changed since last animation step
+{
+    for( int i=m_animIndex; i<m_animNodes.size(); ++i ) // Not updated in last step
+    {
+        eNode* node = m_animNodes.at( i );
+        if( node->m_voltChanged ) continue; // Already in the list
+        node->m_voltChanged = true;
+        addToAnimNodes( node );
+    }
+    m_animNodes.clear();
+    m_animIndex = 0;
+
+    while( m_animNode ){
+        m_animNode->m_voltChanged = false;
+        m_animNodes.append( m_animNode );
+        m_animNode = m_animNode->nextAnim;
+}   }
+
+void Simulator::updateAnimNodes() // Update Connectors in visible area until time budget is exhausted
+{
+    QRectF area = m_observer->simViewArea();
+    uint64_t start = m_RefTimer.nsecsElapsed();
+
+    while( m_animIndex < m_animNodes.size() )
+    {
+        m_animNodes.at( m_animIndex++ )->updateConnectors( area );
+        if( m_RefTimer.nsecsElapsed()-start > m_animBudget ) break; // Remaining nodes in next step
+}   }
+
 void Simulator::runCircuit()
 {
+    TRACE_SPAN("runCircuit");
     solveCircuit(); // Solve any pending changes
     if( m_state < SIM_RUNNING ) return;
 
@@ -165,7 +201,8 @@ void Simulator::runCircuit()
             m_firstEvent = event->nextEvent;    // free Event
             event->nextEvent = nullptr;
             event->eventTime = 0;
-            event->runEvent();                  // Run event callback
+            if( m_profiler ) m_profiler->runEvent( event );
+            else             event->runEvent(); // Run event callback
             event = m_firstEvent;
             if( event ) nextTime = event->eventTime;
             else break;
@@ -180,6 +217,7 @@ void Simulator::runCircuit()
 
 void Simulator::solveCircuit()
 {
+    TRACE_SPAN("solveCircuit");
     while( m_changedNode || m_nonLinear || !m_converged ) // Also Proccess changes gererated in voltChanged()
     {
         if( m_changedNode ) solveMatrix();
@@ -188,9 +226,11 @@ void Simulator::solveCircuit()
         while( !m_converged )              // Non Linear Components
         {
             m_converged = true;
+            if( m_profiler ) m_profiler->nlIteration();
             while( m_nonLinear ){
                 m_nonLinear->added = false;
-                m_nonLinear->voltChanged();
+                if( m_profiler ) m_profiler->voltChanged( m_nonLinear );
+                else             m_nonLinear->voltChanged();
                 m_nonLinear = m_nonLinear->nextChanged;
             }
             if( m_maxNlstp && (m_NLstep++ >= m_maxNlstp) ) { m_warning = 1; return; } // Max iterations reached
@@ -203,7 +243,8 @@ void Simulator::solveCircuit()
         while( m_voltChanged )
         {
             m_voltChanged->added = false;
-            m_voltChanged->voltChanged();
+            if( m_profiler ) m_profiler->voltChanged( m_voltChanged );
+            else             m_voltChanged->voltChanged();
             m_voltChanged = m_voltChanged->nextChanged;
         }
         if( m_state < SIM_RUNNING ) break;    // Loop broken without converging
@@ -226,11 +267,14 @@ void Simulator::resetSim()
     ///m_pauseCirc = false;
     m_simPsPF = 1;
 
-    InfoWidget::self()->setCircTime( 0 );
+    m_observer->simTime( 0 );
     clearEventList();
     m_changedNode = nullptr;
     m_voltChanged = nullptr;
     m_nonLinear = nullptr;
+    m_animNode  = nullptr;
+    m_animNodes.clear();
+    m_animIndex = 0;
 }
 
 void Simulator::createNodes()
@@ -271,6 +315,13 @@ void Simulator::createNodes()
     /// qDebug() <<"  Created      "<< i << "\teNodes"<<pinList.size()<<"Pins";
 }
 
+void Simulator::setObserver( SimObserver* o )
+{
+    m_observer = o ? o : &m_noObserver;
+    m_observer->simTargetSpeed( 100*m_psPerSec/1e12 );
+    if( !isRunning() ) m_observer->simMessage( " "+tr("Stopped")+" ", 1 );
+}
+
 void Simulator::startSim( bool paused )
 {
     resetSim();
@@ -294,14 +345,22 @@ void Simulator::startSim( bool paused )
     }
 
     qDebug() <<"  Initializing "<< m_eNodeList.size()<< "\teNodes";
+    m_animNode = nullptr;
     for( int i=0; i<m_eNodeList.size(); i++ )         // Initialize eNodes
     {
         eNode* enode = m_eNodeList.at(i);
         enode->setNodeNumber( i+1 );
         enode->initialize();
+        enode->m_voltChanged = true;                  // Animate all wires at start
+        addToAnimNodes( enode );
         //qDebug() << "initializing  "<< enode->itemId();
     }
-    for( eElement* el : m_elementList ) el->stamp();
+    if( m_profiler ){
+        m_profiler->reset();
+        m_profiler->commit( m_circTime );
+        for( eElement* el : m_elementList ) m_profiler->stamp( el );
+    }
+    else for( eElement* el : m_elementList ) el->stamp();
 
     m_matrix->createMatrix( m_eNodeList );
 
@@ -341,6 +400,7 @@ void Simulator::stopSim()
     }
     m_state = SIM_STOPPED;
     if( !m_CircuitFuture.isFinished() ) m_CircuitFuture.waitForFinished();
+    if( m_profiler ) m_profiler->commit( m_circTime );
 
     qDebug() << "\n    Simulation Stopped ";
     qDebug() << "\n-------------------------------------------------\n ";
@@ -353,6 +413,205 @@ void Simulator::stopSim()
     m_changedNode = nullptr;
 }
 
+QList<eElement*> Simulator::checkpointElements() // Periodic groups are saved with the events
+{
+    QList<eElement*> list;
+    for( eElement* el : m_elementList ) if( !dynamic_cast<ePeriodic*>( el ) ) list.append( el );
+    return list;
+}
+
+QStringList Simulator::unsavedElements() // Checkpoint won't restore these exactly
+{
+    QStringList list;
+    for( eElement* el : checkpointElements() ) if( el->unsavedState() ) list.append( el->getId() );
+    return list;
+}
+
+#define CHECKPOINT_MAGIC   0x53494D43 // "SIMC"
+#define CHECKPOINT_VERSION 2
+
+bool Simulator::saveCheckpoint( QString fileName )
+{
+    if( m_state != SIM_PAUSED ) { qDebug() << "Simulator::saveCheckpoint Error: Simulation not paused"; return false; }
+    m_CircuitFuture.waitForFinished();
+
+    QFile file( fileName );
+    if( !file.open( QFile::WriteOnly | QFile::Truncate ) )
+    {
+        qDebug() << "Simulator::saveCheckpoint Error: Could not open:\n" << fileName;
+        return false;
+    }
+    QDataStream out( &file );
+    out.setVersion( QDataStream::Qt_5_0 );
+
+    out << (quint32)CHECKPOINT_MAGIC << (quint32)CHECKPOINT_VERSION;
+    out << (quint64)m_circTime << (quint64)m_tStep;
+
+    out << (quint32)m_eNodeList.size();
+    for( eNode* node : m_eNodeList ) out << node->getVolt();
+
+    QList<eElement*> elements = checkpointElements();
+    QHash<eElement*, qint32> index;
+    out << (quint32)elements.size();
+    for( int i=0; i<elements.size(); ++i )
+    {
+        eElement* el = elements.at(i);
+        index[el] = i;
+
+        QByteArray state;
+        QDataStream elOut( &state, QIODevice::WriteOnly );
+        elOut.setVersion( QDataStream::Qt_5_0 );
+        el->saveState( elOut );
+        out << el->getId() << state;
+    }
+    QByteArray events;     // Event list in order: time is relative to m_circTime
+    QDataStream evOut( &events, QIODevice::WriteOnly );
+    evOut.setVersion( QDataStream::Qt_5_0 );
+    quint32 count = 0;
+    for( eElement* event=m_firstEvent; event; event=event->nextEvent )
+    {
+        quint64 relTime = event->eventTime-m_circTime;
+
+        if( ePeriodic* group = dynamic_cast<ePeriodic*>( event ) )
+        {
+            std::vector<eElement*>* members = group->members();
+            QVector<qint32> ids;
+            for( eElement* el : *members ) if( el && index.contains( el ) ) ids.append( index.value( el ) );
+            evOut << (quint8)1 << relTime << group->period() << group->remainder() << ids;
+        }else{
+            if( !index.contains( event ) ) continue;
+            evOut << (quint8)0 << relTime << index.value( event );
+        }
+        count++;
+    }
+    out << count;
+    out.writeRawData( events.constData(), events.size() );
+    file.close();
+
+    if( out.status() != QDataStream::Ok )
+    {
+        qDebug() << "Simulator::saveCheckpoint Error writing:\n" << fileName;
+        return false;
+    }
+    return true;
+}
+
+bool Simulator::loadCheckpoint( QString fileName )
+{
+    if( m_state != SIM_PAUSED ) { qDebug() << "Simulator::loadCheckpoint Error: Simulation not paused"; return false; }
+    m_CircuitFuture.waitForFinished();
+
+    QFile file( fileName );
+    if( !file.open( QFile::ReadOnly ) )
+    {
+        qDebug() << "Simulator::loadCheckpoint Error: Could not open:\n" << fileName;
+        return false;
+    }
+    QDataStream in( &file );
+    in.setVersion( QDataStream::Qt_5_0 );
+
+    quint32 magic, version;
+    in >> magic >> version;
+    if( magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION )
+    {
+        qDebug() << "Simulator::loadCheckpoint Error: Not a valid checkpoint file:\n" << fileName;
+        return false;
+    }
+    quint64 circTime, tStep;
+    in >> circTime >> tStep;
+
+    quint32 nodes;
+    in >> nodes;
+    if( nodes != (quint32)m_eNodeList.size() )
+    {
+        qDebug() << "Simulator::loadCheckpoint Error: Checkpoint doesn't match Circuit (eNodes)";
+        return false;
+    }
+    QVector<double> volts( nodes );
+    for( quint32 i=0; i<nodes; ++i ) in >> volts[i];
+
+    QList<eElement*> elements = checkpointElements();
+    quint32 elCount;
+    in >> elCount;
+    if( elCount != (quint32)elements.size() )
+    {
+        qDebug() << "Simulator::loadCheckpoint Error: Checkpoint doesn't match Circuit (eElements)";
+        return false;
+    }
+    QVector<QByteArray> states( elCount );
+    for( quint32 i=0; i<elCount; ++i )
+    {
+        QString id;
+        in >> id >> states[i];
+        if( id == elements.at(i)->getId() ) continue;
+        qDebug() << "Simulator::loadCheckpoint Error: Checkpoint doesn't match Circuit:"<<id;
+        return false;
+    }
+    struct event_t{
+        quint8  type;
+        quint64 relTime;
+        qint32  index;
+        double  period;
+        double  remainder;
+        QVector<qint32> members;
+    };
+    quint32 evCount;
+    in >> evCount;
+    QVector<event_t> events( evCount );
+    for( event_t& ev : events )
+    {
+        in >> ev.type >> ev.relTime;
+        if( ev.type ) in >> ev.period >> ev.remainder >> ev.members;
+        else          in >> ev.index;
+    }
+    if( in.status() != QDataStream::Ok )
+    {
+        qDebug() << "Simulator::loadCheckpoint Error reading:\n" << fileName;
+        return false;
+    }
+    file.close();
+
+    clearEventList();
+    for( eElement* el : m_elementList ) { el->eventTime = 0; el->nextEvent = nullptr; }
+
+    m_circTime = circTime;
+    m_tStep    = tStep;
+    m_lastStep = tStep;
+
+    for( quint32 i=0; i<nodes; ++i ) m_eNodeList.at(i)->setVolt( volts.at(i) );
+
+    for( int i=events.size()-1; i>=0; --i ) // Reversed: addEvent inserts before same time events
+    {
+        const event_t& ev = events.at(i);
+        if( ev.type )
+        {
+            ePeriodic* group = new ePeriodic( ev.period );
+            group->setRemainder( ev.remainder );
+            for( qint32 m : ev.members ) if( m >= 0 && m < elements.size() ) group->addMember( elements.at( m ) );
+            m_periodic.push_back( group );
+            addEvent( ev.relTime, group );
+        }
+        else if( ev.index >= 0 && ev.index < elements.size() )
+            addEvent( ev.relTime, elements.at( ev.index ) );
+    }
+    for( quint32 i=0; i<elCount; ++i ) // After events: elements can cancel stale ones
+    {
+        if( states.at(i).isEmpty() ) continue;
+        QDataStream elIn( states[i] );
+        elIn.setVersion( QDataStream::Qt_5_0 );
+        elements.at(i)->loadState( elIn );
+        if( elIn.status() == QDataStream::Ok ) continue;
+
+        QString id = elements.at(i)->getId();
+        qDebug() << "Simulator::loadCheckpoint Error: State doesn't match:"<<id;
+        m_observer->simError( "Checkpoint State doesn't match: "+id ); // Partially restored: stop
+        return false;
+    }
+    for( Updatable* el : m_updateList ) el->updateStep();
+    m_observer->simTime( m_circTime );
+    return true;
+}
+
 void Simulator::pauseSim() // Only pause simulation, don't update UI
 {
     if( m_state <= SIM_PAUSED ) return;
@@ -366,6 +625,16 @@ void Simulator::resumeSim()
     m_state = m_oldState;
 }
 
+void Simulator::waitCircuit()
+{
+    if( m_CircuitFuture.isFinished() ) return;
+
+    simState_t state = m_state;
+    m_state = SIM_WAITING;
+    m_CircuitFuture.waitForFinished();
+    m_state = state;
+}
+
 /*void Simulator::stopTimer()
 {
     if( m_timerId == 0 ) return;
@@ -395,6 +664,12 @@ void Simulator::setFps( uint64_t fps )
     setPsPerSec( m_psPerSec );
 }
 
+void Simulator::setAnimBudget( int ms )
+{
+    if( ms < 1 ) ms = 1;
+    m_animBudget = ms*1e6;
+}
+
 void Simulator::setStepsPerSec( uint64_t sps )
 {
     if( sps < 1 ) sps = 1;
@@ -403,6 +678,19 @@ void Simulator::setStepsPerSec( uint64_t sps )
     setPsPerSec( m_stepsPS*m_stepSize );
 }
 
+void Simulator::setProfiling( bool p )
+{
+    if( p == profiling() ) return;
+
+    waitCircuit(); // Don't change profiler while circuit thread is running
+    if( p ){
+        m_profileData.reset();
+        m_profileData.commit( m_circTime );
+        m_profiler = &m_profileData;
+    }
+    else m_profiler = nullptr;
+}
+
 void Simulator::setPsPerSec( uint64_t psPs )
 {
     if( psPs < 1 ) psPs = 1;
@@ -418,12 +706,16 @@ void Simulator::setPsPerSec( uint64_t psPs )
     }
     m_timerTick_ms = 1000/fps;  // in ms
 
-    InfoWidget::self()->setTargetSpeed( 100*m_psPerSec/1e12 );
+    m_observer->simTargetSpeed( 100*m_psPerSec/1e12 );
 }
 
 void Simulator::clearEventList()
 {
     m_firstEvent = nullptr;
+
+    std::vector<ePeriodic*> periodic;
+    periodic.swap( m_periodic );
+    for( ePeriodic* group : periodic ) delete group;
 }
 void Simulator::addEvent( uint64_t time, eElement* el )
 {
@@ -432,6 +724,8 @@ void Simulator::addEvent( uint64_t time, eElement* el )
     if( el->eventTime )
     { qDebug() << "Warning: Simulator::addEvent Repeated event"<<el->getId(); return; }
 
+    if( m_profiler ) m_profiler->eventAdded();
+
     time += m_circTime;
     eElement* last  = nullptr;
     eElement* event = m_firstEvent;
@@ -452,6 +746,8 @@ void Simulator::addEvent( uint64_t time, eElement* el )
 void Simulator::cancelEvents( eElement* el )
 {
     if( el->eventTime == 0 ) return;
+    if( m_profiler ) m_profiler->eventCancelled();
+
     eElement* event = m_firstEvent;
     eElement* last  = nullptr;
     eElement* next  = nullptr;
@@ -469,6 +765,48 @@ void Simulator::cancelEvents( eElement* el )
         event = next;
 }   }
 
+void Simulator::addPeriodic( double period, uint64_t time, eElement* el )
+{
+    if( m_state < SIM_STARTING ) return;
+    if( period < 1 ) period = 1;
+    if( time < 1 ) time = 1;
+
+    uint64_t eventTime = m_circTime+time;
+    for( uint i=0; i<m_periodic.size(); ++i )
+    {
+        ePeriodic* group = m_periodic[i];
+        if( group->isEmpty() && !group->running() && !group->eventTime ) // Emptied while running: delete now
+        {
+            m_periodic.erase( m_periodic.begin()+i-- );
+            delete group;
+            continue;
+        }
+        if( group->period() != period || group->eventTime != eventTime ) continue;
+        group->addMember( el );  // Same period and phase: join this group
+        return;
+    }
+    ePeriodic* group = new ePeriodic( period );
+    group->addMember( el );
+    m_periodic.push_back( group );
+    addEvent( time, group );
+}
+
+void Simulator::remPeriodic( eElement* el )
+{
+    for( uint i=0; i<m_periodic.size(); ++i )
+    {
+        ePeriodic* group = m_periodic[i];
+        if( !group->remMember( el ) ) continue;
+        if( !group->isEmpty() ) return;
+
+        cancelEvents( group );
+        if( group->running() ) return; // Deleted at next addPeriodic()
+
+        m_periodic.erase( m_periodic.begin()+i );
+        delete group;
+        return;
+}   }
+
 void Simulator::addToEnodeList( eNode* nod )
 { if( !m_eNodeList.contains(nod) ) m_eNodeList.append( nod ); }
 
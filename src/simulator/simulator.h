@@ -8,6 +8,8 @@
 
 #include "e-node.h"
 #include "e-element.h"
+#include "simobserver.h"
+#include "simprofiler.h"
 
 enum simState_t{
     SIM_STOPPED=0,
@@ -21,6 +23,8 @@ enum simState_t{
 
 #include <QElapsedTimer>
 #include <QFuture>
+#include <QVector>
+#include <QStringList>
 
 class BaseProcessor;
 class Updatable;
@@ -28,6 +32,7 @@ class eElement;
 class Socket;
 class eNode;
 class CircMatrix;
+class ePeriodic;
 
 class Simulator : public QObject
 {
@@ -43,15 +48,33 @@ class Simulator : public QObject
          void addEvent( uint64_t time, eElement* el );
          void cancelEvents( eElement* el );
 
+         // Periodic events: runEvent() called every period (ps), first at time from now.
+         // Elements with same period and phase share one event.
+         void addPeriodic( double period, uint64_t time, eElement* el );
+         void remPeriodic( eElement* el );
+
+        void setObserver( SimObserver* o );
+        SimObserver* observer() { return m_observer; }
+
         void startSim( bool paused=false );
         void pauseSim();
         void resumeSim();
         void stopSim();
 
+        void waitCircuit(); // From GUI thread: Simulation thread is stopped until next timerEvent()
+
+        // Checkpoint: save/restore simulation state, only while paused
+        bool saveCheckpoint( QString fileName );
+        bool loadCheckpoint( QString fileName );
+        QStringList unsavedElements();
+
         void setWarning( int warning ) { m_warning = warning; }
         
         uint64_t fps() { return m_fps; }
         void setFps( uint64_t fps );
+
+        int animBudget() { return m_animBudget/1e6; }   // Milliseconds
+        void setAnimBudget( int ms );
         uint64_t psPerFrame() { return m_psPF; }
         uint64_t simPsPF() { return m_simPsPF; }
 
@@ -70,6 +93,9 @@ class Simulator : public QObject
         void  setSlopeSteps( int steps ) { m_slopeSteps = steps; }
         int slopeSteps( ) { return m_slopeSteps; }
 
+        void setCollapseSlopes( bool c ) { m_collapseSlopes = c; } // No slopes in nets with only logic pins
+        bool collapseSlopes() { return m_collapseSlopes; }
+
         void  setMaxNlSteps( uint32_t steps ) { m_maxNlstp = steps; }
         uint32_t maxNlSteps( ) { return m_maxNlstp; }
         
@@ -94,6 +120,13 @@ class Simulator : public QObject
         
         void addToUpdateList( Updatable* el );
         void remFromUpdateList( Updatable* el );
+        bool isUpdated( Updatable* el ) { return m_updateList.contains( el ); }
+
+        // Profiler: profiler() is null while profiling is disabled
+        void setProfiling( bool p );
+        bool profiling() { return m_profiler != nullptr; }
+        SimProfiler* profiler() { return m_profiler; }
+        SimProfiler* profileData() { return &m_profileData; }
 
         void addToSocketList( Socket* el );
         void remFromSocketList( Socket* el );
@@ -103,10 +136,13 @@ class Simulator : public QObject
 
         // Accelerate calls from eNode:
         inline void addToChangedNodes( eNode* nod ) { nod->nextCH = m_changedNode; m_changedNode = nod; }
+        inline void addToAnimNodes( eNode* nod ) { nod->nextAnim = m_animNode; m_animNode = nod; }
         inline void addToChangedList( eElement* el ) { el->nextChanged = m_voltChanged; m_voltChanged = el; }
         inline void addToNoLinList( eElement* el ) { el->nextChanged = m_nonLinear;  m_nonLinear = el; }
 
         void createNodes();
+        void takeAnimNodes();
+        void updateAnimNodes();
         void resetSim();
         void runCircuit();
         inline void solveCircuit();
@@ -114,21 +150,35 @@ class Simulator : public QObject
 
         inline void clearEventList();
 
+        QList<eElement*> checkpointElements();
+
         //inline void stopTimer();
         //inline void initTimer();
 
         eElement* m_firstEvent;
 
+        std::vector<ePeriodic*> m_periodic;
+
         QFuture<void> m_CircuitFuture;
 
         CircMatrix* m_matrix;
 
+        SimObserver* m_observer;
+        SimObserver  m_noObserver;
+
+        SimProfiler* m_profiler;
+        SimProfiler  m_profileData;
+
         QHash<int, QString> m_errors;
         QHash<int, QString> m_warnings;
 
         QList<eNode*> m_eNodeList;
 
         eNode*    m_changedNode;
+        eNode*    m_animNode;     // Nodes changed since last animation step
+
+        QVector<eNode*> m_animNodes; // Nodes to update in animation step
+        int m_animIndex;
         eElement* m_voltChanged;
         eElement* m_nonLinear;
 
@@ -142,6 +192,7 @@ class Simulator : public QObject
         bool m_debug;
         bool m_converged;
         bool m_pauseCirc;
+        bool m_collapseSlopes;
 
         int m_error;
         int m_warning;
@@ -171,6 +222,7 @@ class Simulator : public QObject
         uint64_t m_loopTime;
         uint64_t m_guiTime;
         uint64_t m_updtTime;
+        uint64_t m_animBudget; // Max time for wire animation in each step (ns)
         double   m_simLoad;
 
         QElapsedTimer m_RefTimer;